@@ -12,11 +12,30 @@
  *    3. test MIN, FIFO, LRU, LFU, Clock, WS virtual memory management
  *    4. print page fault information, brief data at console
  *    5. print residence set, page fault of each time at output file
+ *    6. (optional, -p) rerun FIFO, LRU, LFU, Clock with a prefetcher on the fault
+ *       path and print useful / wasted prefetch and fault reduction
+ *    7. (optional, -m) interleave reference strings of several processes over a
+ *       shared frame pool and print per process fault and thrashing
+ *    8. (optional, -t) test DRAM + slow tier + swap with LRU, LFU, Clock and print
+ *       per tier hit and modeled average access latency
+ *    9. (optional, -z) test compressed memory pool in front of swap with LRU, LFU,
+ *       Clock and print pool hit, capacity gain and CPU cost against I/O saved
+ *   10. (optional, -s) export reuse distance, per page / per window fault and
+ *       cycles of replace rule as CSV, JSON(vm_instr.c)
  *
  * Written by Dongwon Kim on December 02, 2020
  *
  *  Modification History :
  *    1. Written by Dongwon Kim on December 02, 2020
+ *    2. Prefetcher(next-N, sequential readahead, stride) added on October 19, 2026
+ *    3. Multi-process simulation(global/local replacement, PFF, WS admission) added
+ *       on October 19, 2026
+ *    4. Tiered memory(DRAM + slow tier + swap) added on October 19, 2026
+ *    5. Compressed memory pool(zswap-like) added on October 19, 2026
+ *    6. Replace rule moved to vm_sim.c(re-entrant simulator API) on October 19, 2026
+ *    7. Instrumentation(-s) added on October 19, 2026
+ *    8. Reference string parsed from mapped file by several threads(vm_parse.c)
+ *       on October 19, 2026
  *
  *
  *  Compiler Used : gcc version 7.3.0, 32-bit
@@ -27,60 +46,237 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "vm_rule.h"
+#include "vm_instr.h"
+#include "vm_parse.h"
 #define FILE_LENGTH 100  // keyboard input length limit
 #define PAGE 100         // limit of no. of page
 #define FRAME 20         // limit of no. of page frame allocated
 #define WINDOW 100       // limit of window size
-#define S_LEN 100000     // limit of length of reference string
+#define S_LEN 100000     // limit of length of reference string(if the file can't be mapped)
+#define ECHO_LEN 1000    // reference string longer than this is not printed at console
 #define FALSE -1
+#define PROC 10          // limit of no. of process(multi-process mode)
+#define POOL 200         // limit of no. of shared page frame(multi-process mode)
+
+// prefetch mode
+#define PF_NONE 0        // no prefetch(demand paging only)
+#define PF_NEXT 1        // fixed next-N pages
+#define PF_SEQ 2         // adaptive sequential readahead window
+#define PF_STRIDE 3      // constant stride detector
+#define PF_DEPTH 4       // default prefetch depth
+#define PF_SEQ_INIT 2    // initial readahead window of PF_SEQ
+
+/*
+ * state of the prefetcher on the fault path
+ * flag, loaded are indexed by page frame like mem, mark
+ */
+typedef struct{
+    int mode;            // PF_NONE, PF_NEXT, PF_SEQ, PF_STRIDE
+    int depth;           // N of next-N, max window of seq, lookahead of stride
+    int last;            // page no. of the previous fault(-1: none)
+    int stride;          // stride between the previous two faults
+    int window;          // current readahead window(seq)
+    int ra_end;          // last page of the previous readahead(seq, -1: none)
+    int flag[FRAME];     // 1 if the frame has prefetched page not referenced yet
+    int loaded[FRAME];   // time the frame was filled
+    int issued;          // no. of page brought in by prefetch
+    int useful;          // prefetched page referenced before eviction
+    int wasted;          // prefetched page evicted(or left) without reference
+} Prefetcher;
+
+// frame allocation of multi-process mode(index of mp_name)
+#define MP_GLOBAL_LRU 0     // one LRU list over the whole pool
+#define MP_GLOBAL_CLOCK 1   // one clock over the whole pool
+#define MP_LOCAL 2          // fixed local allocation, LRU within own frames
+#define MP_PFF 3            // Page Fault Frequency
+#define MP_WS 4             // working set with admission control
+#define THRASH_RATE 0.5     // quantum whose fault rate is over it is thrashing
+
+// tiered memory(-t, -l)
+#define TIER 100            // limit of no. of frame of slow tier
+#define DRAM_NS 100         // default access latency of DRAM(ns)
+#define SLOW_NS 300         // default access latency of slow tier(CXL, compressed)(ns)
+#define SWAP_NS 50000       // default latency of swap in(ns)
+
+// compressed memory pool(-z)
+#define PAGE_SIZE 4096      // size of page(byte)
+#define COMP_NS 3000        // CPU time to compress a page(ns)
+#define DECOMP_NS 1000      // CPU time to decompress a page(ns)
+#define RATIO_MIN 1.0       // default range of compression ratio drawn at random
+#define RATIO_MAX 4.0
+#define RATIO_SEED 1        // seed of compression ratio drawn at random
+
+/*
+ * process of multi-process mode
+ * string and header(page, page_frame, window, string_length) are same as single process input
+ */
+typedef struct{
+    int page;            // no. of page of the process
+    int page_frame;      // no. of frame of fixed local allocation
+    int window;          // window size(WS), critical inter-fault time(PFF)
+    int string_length;   // length of string
+    int *string;         // reference string
+    int pos;             // next index of string(= virtual time of the process)
+    int fault;           // no. of page fault
+    int resident;        // no. of frame occupied now
+    int last_fault;      // virtual time of the last fault(PFF)
+    int last_use[PAGE];  // virtual time of the last reference of each page(WS)
+    int active;          // 1 if admitted to memory(WS)
+    int ws_estimate;     // resident set size when swapped out(WS admission)
+    int suspend;         // no. of time swapped out(WS)
+    int quanta;          // no. of quantum executed
+    int thrash;          // no. of quantum whose fault rate is over THRASH_RATE
+} Process;
+
+/*
+ * one memory tier, frames are managed by a fixed allocation replace rule
+ * mem, mark, tie_break, needle have same meaning as in *_test
+ */
+typedef struct{
+    int size;                // no. of frame
+    int latency;             // access latency(ns)
+    int mem[TIER];           // page no. in each frame(-1: free)
+    int mark[TIER];          // used time(LRU), used count(LFU), reference bit(Clock)
+    int tie_break[TIER];     // used time(LFU)
+    int access[TIER];        // no. of access since the page came into this tier
+    int needle;              // clock hand
+    int hit;                 // no. of reference served by this tier
+} Tier;
+
+/*
+ * command line option
+ */
+typedef struct{
+    Prefetcher pf;       // -p
+    int multi;           // -m, 1 if input file has several processes
+    int slow_frame;      // -t, no. of frame of slow tier(-1: tier test off)
+    int promote;         // -t, no. of access in slow tier to be promoted to DRAM
+    int latency[3];      // -l, latency of DRAM, slow tier, swap(ns)
+    long pool_byte;      // -z, capacity of compressed pool(byte, -1: pool test off)
+    double ratio_min;    // -z, range of compression ratio drawn at random
+    double ratio_max;
+    char *stat_prefix;   // -s, path prefix of statistics file(NULL: off)
+    int stat_window;     // -s, no. of reference of a fault rate window
+} Option;
+
+char *policy_name[] = {"MIN", "FIFO", "LRU", "LFU", "Clock", "WS"};
+char *pf_name[] = {"none", "next", "seq", "stride"};
+char *mp_name[] = {"global LRU", "global Clock", "local LRU", "PFF", "WS"};
+char *tier_name[] = {"DRAM", "slow", "swap"};
 
 /*
  * function prototypes
  */
-void VM_Test(int page, int page_frame, int window, int *string, int string_length, FILE *outfile);
+void VM_Test(int page, int page_frame, int window, int *string, int string_length, FILE *outfile, Prefetcher *pf, Instr *ins);
+int get_option(int argc, char *argv[], Option *option);
+void MP_Test(Process *proc, int proc_no, int quantum, int pool_size, FILE *outfile);
+void Tier_Test(int page_frame, int *string, int string_length, Option *option, FILE *outfile);
+void Zswap_Test(int page, int page_frame, int *string, int string_length, double *ratio, Option *option, FILE *outfile);
 // input
 FILE *get_file(void);
 FILE *rand_input(void);
 int *get_data(FILE *infile, int *page, int *page_frame, int *window, int *string_length);
+Process *get_process(FILE *infile, int *proc_no, int *quantum, int *pool_size);
+int get_ratio(FILE *infile, int page, double *ratio, Option *option);
 // primary functions
-void mem_init(int *mem, int page_frame);
-int in_mem(int *mem, int page_frame, int key);
 int print_residence(int *array, int size, FILE *outfile, int time, int VA);
+void print_title(int policy, Prefetcher *pf, FILE *outfile);
 int find_min(int *string, int size);
 int find_max(int *string, int size);
 // memory management test
-void MIN_test(int *mark, int *mem, int page_frame, int *string, int string_length, FILE *outfile);
-void FIFO_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile);
-void LRU_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile);
-void LFU_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile);
-void Clock_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile);
-void WS_test(int page, int window, int *page_mark, int *string, int string_length, FILE *outfile);
-// replace rule
-int MIN_replace(int *mark, int *mem, int page_frame, int *string, int string_length, int time);
-int FIFO_replace(int *mem, int *mark, int page_frame);
-int LRU_replace(int *mem, int *mark, int page_frame);
-int LFU_replace(int *mem, int *mark, int *tie_break, int page_frame);
-int Clock_replace(int *mem, int *mark, int page_frame);
+void MIN_test(int *mark, int *mem, int page_frame, int *string, int string_length, FILE *outfile, Instr *ins);
+int FIFO_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile, int page, Prefetcher *pf, Instr *ins);
+int LRU_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile, int page, Prefetcher *pf, Instr *ins);
+int LFU_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile, int page, Prefetcher *pf, Instr *ins);
+int Clock_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile, int page, Prefetcher *pf, Instr *ins);
+void WS_test(int page, int window, int *page_mark, int *string, int string_length, FILE *outfile, Instr *ins);
+// prefetch
+void prefetch_reset(Prefetcher *pf);
+int prefetch_pages(Prefetcher *pf, int key, int page, int *candidate);
+void prefetch_hit(Prefetcher *pf, int index);
+void prefetch_evict(Prefetcher *pf, int index, int time);
+void prefetch_load(Prefetcher *pf, int policy, int *mem, int *mark, int *tie_break, int *needle,
+                   int page_frame, int page, int key, int time, FILE *outfile);
+void prefetch_report(Prefetcher *pf, int policy, int fault_demand, int fault_prefetch, FILE *outfile);
+// multi-process
+int MP_run(int mode, Process *proc, int proc_no, int quantum, int pool_size, FILE *outfile);
+int MP_find(int *pool_pid, int *pool_page, int pool_size, int pid, int key);
+int MP_replace(int mode, Process *proc, int proc_no, int pid, int *pool_pid, int *pool_page, int *pool_mark,
+               int pool_size, int *needle, FILE *outfile, int time);
+void MP_evict(Process *proc, int *pool_pid, int *pool_page, int *pool_mark, int index);
+// tiered memory
+int Tier_run(int policy, Tier *dram, Tier *slow, int promote, int swap_ns, int *string, int string_length, FILE *outfile);
+int Tier_insert(int policy, Tier *tier, int key, int time);
+// compressed memory pool
+int Zswap_run(int policy, int page, int page_frame, int *string, int string_length, double *ratio,
+              long pool_byte, int swap_ns, FILE *outfile);
+void Zswap_sample(int pool_page, long pool_used, double *pool_page_sum, double *pool_byte_sum,
+                  double *gain_sum, int *gain_sample);
 
 /**
  * get input file name from user
  * get data from input file
  * call virtual memory management test function
  *
- * input: none
+ * input:
+ *    int argc, char *argv[]: command line option
+ *        -p <next|seq|stride> [depth]: also test with prefetcher on the fault path
+ *        -m: input file has several processes(multi-process mode)
+ *        -t <slow frame> [promote]: also test DRAM(page_frame) + slow tier + swap
+ *        -l <DRAM ns> <slow ns> <swap ns>: latency of each tier for -t, -z
+ *        -z <pool byte> [min ratio] [max ratio]: also test compressed pool in front of swap
+ *        -s <prefix> [window]: export statistics of normal test to <prefix>*.csv, <prefix>.json
+ *
  * output:
  *    return int 0 (successful termination)
  *               -1 (file opening failed)
  *               -2 (file format not matched)
  *               -3 (dynamic memory allocation failed)
+ *               -4 (command line option not matched)
  */
-int main(){
+int main(int argc, char *argv[]){
+    // get option before asking file name
+    Option option;
+    if(get_option(argc, argv, &option) != 0){
+        printf("usage: %s [-p <next|seq|stride> [depth(1~%d)]] [-m] [-t <slow frame(0~%d)> [promote]]"
+               " [-l <DRAM ns> <slow ns> <swap ns>] [-z <pool byte> [min ratio] [max ratio]] [-s <prefix> [window]]\n",
+               argv[0], FRAME, TIER);
+        exit(-4);
+    }
+
     // get file name from user
     FILE *infile = get_file();
 
+    // multi-process mode: several processes share the frame pool
+    if(option.multi == 1){
+        int proc_no, quantum, pool_size;
+        Process *proc = get_process(infile, &proc_no, &quantum, &pool_size);
+        fclose(infile);
+        FILE *outfile = fopen("output.txt", "w");
+        if(outfile == NULL){
+            printf("[Error] file opening failed\n");
+            exit(-1);
+        }
+
+        MP_Test(proc, proc_no, quantum, pool_size, outfile);
+
+        fclose(outfile);
+        for(int i = 0; i < proc_no; i++){
+            free(proc[i].string);
+        }
+        free(proc);
+        return 0;
+    }
+
     // get data from input file
     int page, page_frame, window, string_length;
     int *string = get_data(infile, &page, &page_frame, &window, &string_length);
+    // compression ratio of each page(from the line after string, or random)
+    double ratio[PAGE];
+    if(option.pool_byte != -1){
+        get_ratio(infile, page, ratio, &option);
+    }
     fclose(infile);
     FILE *outfile = fopen("output.txt", "w");
     if(outfile == NULL){
@@ -88,14 +284,152 @@ int main(){
         exit(-1);
     }
 
+    // statistics of the trace and each policy(-s)
+    Instr ins;
+    if(option.stat_prefix != NULL){
+        if(instr_create(&ins, string, string_length, page, option.stat_window) != VM_OK){
+            printf("[Error] Dynamic memory allocation failed\n");
+            exit(-3);
+        }
+    }
+
     // simulation
-    VM_Test(page, page_frame, window, string, string_length, outfile);
+    VM_Test(page, page_frame, window, string, string_length, outfile, &option.pf,
+            option.stat_prefix != NULL ? &ins : NULL);
+    if(option.stat_prefix != NULL){
+        if(instr_export(&ins, option.stat_prefix) != VM_OK){
+            printf("[Error] file opening failed\n");
+            exit(-1);
+        }
+        printf("statistics: %s_reuse.csv %s_page.csv %s_fault.csv %s_replace.csv %s.json\n", option.stat_prefix,
+               option.stat_prefix, option.stat_prefix, option.stat_prefix, option.stat_prefix);
+        instr_free(&ins);
+    }
+    if(option.slow_frame != -1){
+        Tier_Test(page_frame, string, string_length, &option, outfile);
+    }
+    if(option.pool_byte != -1){
+        Zswap_Test(page, page_frame, string, string_length, ratio, &option, outfile);
+    }
 
     fclose(outfile);
     free(string);
     return 0;
 }
 
+/**
+ * parse command line option
+ *
+ * input:
+ *    int argc, char *argv[]: command line option
+ *
+ * output:
+ *    Option *option: pf.mode, pf.depth, multi, slow_frame, promote, latency,
+ *                    pool_byte, ratio_min, ratio_max, stat_prefix, stat_window are set
+ *                    (PF_NONE, 0, -1, NULL and defaults if not given)
+ *    return int 0 (success), -1 (option not matched or -m with -p, -t, -l, -z, -s)
+ */
+int get_option(int argc, char *argv[], Option *option){
+    Prefetcher *pf = &option->pf;
+    pf->mode = PF_NONE;
+    pf->depth = PF_DEPTH;
+    option->multi = 0;
+    option->slow_frame = -1;
+    option->promote = 1;
+    option->latency[0] = DRAM_NS;
+    option->latency[1] = SLOW_NS;
+    option->latency[2] = SWAP_NS;
+    option->pool_byte = -1;
+    option->ratio_min = RATIO_MIN;
+    option->ratio_max = RATIO_MAX;
+    option->stat_prefix = NULL;
+    option->stat_window = STAT_WINDOW;
+    int latency_given = 0;
+
+    for(int i = 1; i < argc; i++){
+        if(strcmp(argv[i], "-m") == 0){
+            option->multi = 1;
+        }else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc){
+            i++;
+            option->slow_frame = atoi(argv[i]);
+            if((option->slow_frame < 0) || (option->slow_frame > TIER)){
+                return -1;
+            }
+            // promote is optional
+            if(i + 1 < argc && argv[i + 1][0] != '-'){
+                i++;
+                option->promote = atoi(argv[i]);
+                if(option->promote < 1){
+                    return -1;
+                }
+            }
+        }else if(strcmp(argv[i], "-z") == 0 && i + 1 < argc){
+            i++;
+            option->pool_byte = atol(argv[i]);
+            if(option->pool_byte < 0){
+                return -1;
+            }
+            // range of ratio is optional
+            if(i + 2 < argc && argv[i + 1][0] != '-'){
+                option->ratio_min = atof(argv[i + 1]);
+                option->ratio_max = atof(argv[i + 2]);
+                i += 2;
+                if((option->ratio_min < 1.0) || (option->ratio_max < option->ratio_min)){
+                    return -1;
+                }
+            }
+        }else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc){
+            i++;
+            option->stat_prefix = argv[i];
+            // window is optional
+            if(i + 1 < argc && argv[i + 1][0] != '-'){
+                i++;
+                option->stat_window = atoi(argv[i]);
+                if(option->stat_window < 1){
+                    return -1;
+                }
+            }
+        }else if(strcmp(argv[i], "-l") == 0 && i + 3 < argc){
+            latency_given = 1;
+            for(int k = 0; k < 3; k++){
+                i++;
+                option->latency[k] = atoi(argv[i]);
+                if(option->latency[k] < 1){
+                    return -1;
+                }
+            }
+        }else if(strcmp(argv[i], "-p") == 0 && i + 1 < argc){
+            i++;
+            if(strcmp(argv[i], "next") == 0){
+                pf->mode = PF_NEXT;
+            }else if(strcmp(argv[i], "seq") == 0){
+                pf->mode = PF_SEQ;
+            }else if(strcmp(argv[i], "stride") == 0){
+                pf->mode = PF_STRIDE;
+            }else{
+                return -1;
+            }
+            // depth is optional
+            if(i + 1 < argc && argv[i + 1][0] != '-'){
+                i++;
+                pf->depth = atoi(argv[i]);
+                if((pf->depth < 1) || (pf->depth > FRAME)){
+                    return -1;
+                }
+            }
+        }else{
+            return -1;
+        }
+    }
+
+    // multi-process mode runs MP_Test only, other tests can't be combined
+    if(option->multi == 1 && (pf->mode != PF_NONE || option->slow_frame != -1 || option->pool_byte != -1
+                              || option->stat_prefix != NULL || latency_given == 1)){
+        return -1;
+    }
+    return 0;
+}
+
 /**
  * create int pointer array using dynamic memory allocation
  * call test functions for each algorithm
@@ -106,11 +440,14 @@ int main(){
  *    int window: window size (for working set)
  *    int *string: int array that contains page reference string
  *    int string_length: length of *string
+ *    Prefetcher *pf: if pf->mode != PF_NONE, FIFO, LRU, LFU, Clock are tested again
+ *                    with the prefetcher and compared with demand paging
+ *    Instr *ins: statistics of the normal test are counted(NULL: off)
  *
  * output:
  *    print residence set and no. of fault for each algorithm
  */
-void VM_Test(int page, int page_frame, int window, int *string, int string_length, FILE *outfile){
+void VM_Test(int page, int page_frame, int window, int *string, int string_length, FILE *outfile, Prefetcher *pf, Instr *ins){
     /*
      * for fixed allocation
      * int *mark: to save information for replacement
@@ -124,75 +461,61 @@ void VM_Test(int page, int page_frame, int window, int *string, int string_lengt
     int *mark = (int *)malloc(sizeof(int) * page_frame);
     int *mem = (int *)malloc(sizeof(int) * page_frame);
     int *page_mark = (int *)malloc(sizeof(int) * page);
+    if(mark == NULL || mem == NULL || page_mark == NULL){
+        printf("[Error] Dynamic memory allocation failed\n");
+        exit(-3);
+    }
     mem_init(mark, page_frame);
     mem_init(mem, page_frame);
     mem_init(page_mark, page);
 
+    // no. of fault of demand paging(index = POL_*), compared with prefetch
+    int fault_demand[POL_CLOCK + 1];
+
     // test each algorithm and initialize the array
-    MIN_test(mark, mem, page_frame, string, string_length, outfile);
+    MIN_test(mark, mem, page_frame, string, string_length, outfile, ins);
     mem_init(mark, page_frame);
     mem_init(mem, page_frame);
-    FIFO_test(mem, mark, page_frame, string, string_length, outfile);
+    fault_demand[POL_FIFO] = FIFO_test(mem, mark, page_frame, string, string_length, outfile, page, NULL, ins);
     mem_init(mark, page_frame);
     mem_init(mem, page_frame);
-    LRU_test(mem, mark, page_frame, string, string_length, outfile);
+    fault_demand[POL_LRU] = LRU_test(mem, mark, page_frame, string, string_length, outfile, page, NULL, ins);
     mem_init(mark, page_frame);
     mem_init(mem, page_frame);
-    LFU_test(mem, mark, page_frame, string, string_length, outfile);
+    fault_demand[POL_LFU] = LFU_test(mem, mark, page_frame, string, string_length, outfile, page, NULL, ins);
     mem_init(mark, page_frame);
     mem_init(mem, page_frame);
-    Clock_test(mem, mark, page_frame, string, string_length, outfile);
+    fault_demand[POL_CLOCK] = Clock_test(mem, mark, page_frame, string, string_length, outfile, page, NULL, ins);
     mem_init(mark, page_frame);
     mem_init(mem, page_frame);
-    WS_test(page, window, page_mark, string, string_length, outfile);
+    WS_test(page, window, page_mark, string, string_length, outfile, ins);
+
+    // test again with prefetcher
+    // MIN already knows the future and WS has no fixed frame to fill, so they are excluded
+    if(pf->mode != PF_NONE){
+        int fault_prefetch[POL_CLOCK + 1];
+        for(int p = POL_FIFO; p <= POL_CLOCK; p++){
+            mem_init(mark, page_frame);
+            mem_init(mem, page_frame);
+            prefetch_reset(pf);
+            if(p == POL_FIFO){
+                fault_prefetch[p] = FIFO_test(mem, mark, page_frame, string, string_length, outfile, page, pf, NULL);
+            }else if(p == POL_LRU){
+                fault_prefetch[p] = LRU_test(mem, mark, page_frame, string, string_length, outfile, page, pf, NULL);
+            }else if(p == POL_LFU){
+                fault_prefetch[p] = LFU_test(mem, mark, page_frame, string, string_length, outfile, page, pf, NULL);
+            }else{
+                fault_prefetch[p] = Clock_test(mem, mark, page_frame, string, string_length, outfile, page, pf, NULL);
+            }
+            prefetch_report(pf, p, fault_demand[p], fault_prefetch[p], outfile);
+        }
+    }
 
     free(mark);
     free(mem);
     free(page_mark);
 }
 
-/**
- * initialize pointer array
- * check if there is error in dynamic memory allocation
- *
- * input:
- *    int page_frame: the no. of page frame allocated to the process
- *
- * in/output:
- *    int *mem: pointer array that is initialized as -1.
- */
-void mem_init(int *mem, int page_frame){
-    if(mem == NULL){
-        printf("[Error] Dynamic memory allocation failed\n");
-        exit(-3);
-    }
-
-    for(int i = 0; i < page_frame; i++){
-        mem[i] = -1;
-    }
-}
-
-/**
- * check if the 'key' is in the array (using linear search)
- *
- * input:
- *    int *mem: the array to be searched
- *    int page_frame: the size of the array
- *    int key: the value to be found
- *
- * output:
- *    return int index of the key(if the key is in the array)
- *           int FALSE(-1) (if search failed)
- */
-int in_mem(int *mem, int page_frame, int key){
-    for(int i = 0; i < page_frame; i++){
-        if(key == mem[i]){
-            return i;
-        }
-    }
-    return FALSE;
-}
-
 /**
  * print residence set to output file
  *
@@ -229,6 +552,26 @@ int print_residence(int *array, int size, FILE *outfile, int time, int VA){
     }
 }
 
+/**
+ * print name of the test at the console and output file
+ *
+ * input:
+ *    int policy: POL_* of the test
+ *    Prefetcher *pf: prefetcher of the test(NULL: demand paging only)
+ *
+ * output:
+ *    FILE *outfile: pointer of output file
+ */
+void print_title(int policy, Prefetcher *pf, FILE *outfile){
+    if(pf == NULL){
+        printf("--%s--\n", policy_name[policy]);
+        fprintf(outfile, "--%s--\n", policy_name[policy]);
+    }else{
+        printf("--%s (prefetch %s %d)--\n", policy_name[policy], pf_name[pf->mode], pf->depth);
+        fprintf(outfile, "--%s (prefetch %s %d)--\n", policy_name[policy], pf_name[pf->mode], pf->depth);
+    }
+}
+
 /**
  * Test function of MIN algorithm
  * check if the page no. is in the mem
@@ -239,6 +582,7 @@ int print_residence(int *array, int size, FILE *outfile, int time, int VA){
  *    int page_frame: no. of page frame allocated, size of mem, mark
  *    int *string: array that contains reference string
  *    int string_length: size of string
+ *    Instr *ins: fault and replace cycle are counted(NULL: off)
  *
  * output:
  *    print information at the console about page fault occurs
@@ -248,8 +592,9 @@ int print_residence(int *array, int size, FILE *outfile, int time, int VA){
  *    int *mark: array to save information for replacement
  *    int *mem: array to save page no. which are in the page frame
  */
-void MIN_test(int *mark, int *mem, int page_frame, int *string, int string_length, FILE *outfile){
+void MIN_test(int *mark, int *mem, int page_frame, int *string, int string_length, FILE *outfile, Instr *ins){
     int replace;
+    unsigned long long start;
     int fault_no = 0;
     printf("--MIN--\n");
     fprintf(outfile, "--MIN--\n");
@@ -259,7 +604,12 @@ void MIN_test(int *mark, int *mem, int page_frame, int *string, int string_lengt
         // page fault
         if(in_mem(mem, page_frame, string[i]) == FALSE){
             // get index to be replaced
+            start = ins != NULL ? instr_cycle() : 0;
             replace = MIN_replace(mark, mem, page_frame, string, string_length, i);
+            if(ins != NULL){
+                instr_replace(ins, POL_MIN, instr_cycle() - start);
+                instr_fault(ins, POL_MIN, string[i], i);
+            }
             mem[replace] = string[i];
             fault_no++;
             printf("<page fault> ");
@@ -273,53 +623,6 @@ void MIN_test(int *mark, int *mem, int page_frame, int *string, int string_lengt
     fprintf(outfile, "Total no. of fault: %d/%d\n", fault_no, string_length);
 }
 
-/**
- * find index to be replaced following MIN algorithm
- *
- * input:
- *    int *mem: array to save page no. which are in the page frame
- *    int page_frame: no. of page frame allocated, size of mem, mark
- *    int *string: array that contains reference string
- *    int string_length: size of string
- *    int time: time of the system, same as index of string + 1
- *
- * output:
- *    return int index to be replaced
- *
- * in/output:
- *    int *mark: save forward distance of page
- */
-int MIN_replace(int *mark, int *mem, int page_frame, int *string, int string_length, int time){
-    int change = 0;
-    for(int i = 0; i < page_frame; i++){
-        for(int j = time; j < string_length; j++){
-            // if the page is referred again in the future, save forward distance
-            if(string[j] == mem[i]){
-                mark[i] = j - time;
-                change = 1;
-                break;
-            }
-        }
-        // if the page is not referred again, save string_length(infinity)
-        // since max forward distance = string_length - 1
-        if(change != 1){
-            mark[i] = string_length;
-        }
-        change = 0;
-    }
-
-    // find page that has maximum forward distance
-    int max = mark[0];
-    int max_no = 0;
-    for(int i = 0; i < page_frame; i++){
-        if(max < mark[i]){
-            max = mark[i];
-            max_no = i;
-        }
-    }
-    return max_no;
-}
-
 /**
  * Test function of FIFO algorithm
  * check if the page no. is in the mem
@@ -330,8 +633,12 @@ int MIN_replace(int *mark, int *mem, int page_frame, int *string, int string_len
  *    int page_frame: no. of page frame allocated, size of mem, mark
  *    int *string: array that contains reference string
  *    int string_length: size of string
+ *    int page: no. of page of the process(upper bound of prefetch)
+ *    Prefetcher *pf: prefetcher on the fault path(NULL: demand paging only)
+ *    Instr *ins: fault and replace cycle are counted(NULL: off)
  *
  * output:
+ *    return int no. of page fault
  *    print information at the console about page fault occurs
  *    FILE *outfile: print resident set, page fault data at the output file
  *
@@ -339,49 +646,42 @@ int MIN_replace(int *mark, int *mem, int page_frame, int *string, int string_len
  *    int *mark: array to save information for replacement
  *    int *mem: array to save page no. which are in the page frame
  */
-void FIFO_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile){
+int FIFO_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile, int page, Prefetcher *pf, Instr *ins){
     int replace;
+    unsigned long long start;
     int fault_no = 0;
-    printf("--FIFO--\n");
-    fprintf(outfile, "--FIFO--\n");
+    int index;
+    print_title(POL_FIFO, pf, outfile);
     for(int i = 0; i < string_length; i++){
+        index = in_mem(mem, page_frame, string[i]);
         // page fault
-        if(in_mem(mem, page_frame, string[i]) == FALSE){
+        if(index == FALSE){
+            start = ins != NULL ? instr_cycle() : 0;
             replace = FIFO_replace(mem, mark, page_frame);
+            if(ins != NULL){
+                instr_replace(ins, POL_FIFO, instr_cycle() - start);
+                instr_fault(ins, POL_FIFO, string[i], i);
+            }
+            if(pf != NULL){
+                prefetch_evict(pf, replace, i);
+            }
             mem[replace] = string[i];
             mark[replace] = i; // mark arrival time
             fault_no++;
             printf("<page fault> ");
             printf("Time %d replaced index %d no. of fault %d\n", i + 1, replace, fault_no);
             fprintf(outfile, "<page fault> Time %d replaced index %d no. of fault %d\n", i + 1, replace, fault_no);
+            if(pf != NULL){
+                prefetch_load(pf, POL_FIFO, mem, mark, NULL, NULL, page_frame, page, string[i], i, outfile);
+            }
+        }else if(pf != NULL){
+            prefetch_hit(pf, index);
         }
         print_residence(mem, page_frame, outfile, i, 0);
     }
     printf("Total no. of fault: %d/%d\n", fault_no, string_length);
     fprintf(outfile, "Total no. of fault: %d/%d\n", fault_no, string_length);
-}
-
-/**
- * find index to be replaced following FIFO algorithm
- *
- * input:
- *    int *mem: array to save page no. which are in the page frame
- *    int *mark: array that has arrival time of pages in the memory
- *    int page_frame: no. of page frame allocated, size of mem, mark
- *
- * output:
- *    return int index to be replaced(index that has minimum arrival time)
- */
-int FIFO_replace(int *mem, int *mark, int page_frame){
-    int min = mark[0];
-    int min_no = 0;
-    for(int i = 0; i < page_frame; i++){
-        if(min > mark[i]){
-            min = mark[i];
-            min_no = i;
-        }
-    }
-    return min_no;
+    return fault_no;
 }
 
 /**
@@ -394,8 +694,12 @@ int FIFO_replace(int *mem, int *mark, int page_frame){
  *    int page_frame: no. of page frame allocated, size of mem, mark
  *    int *string: array that contains reference string
  *    int string_length: size of string
+ *    int page: no. of page of the process(upper bound of prefetch)
+ *    Prefetcher *pf: prefetcher on the fault path(NULL: demand paging only)
+ *    Instr *ins: fault and replace cycle are counted(NULL: off)
  *
  * output:
+ *    return int no. of page fault
  *    print information at the console about page fault occurs
  *    FILE *outfile: print resident set, page fault data at the output file
  *
@@ -403,53 +707,45 @@ int FIFO_replace(int *mem, int *mark, int page_frame){
  *    int *mark: array to save information for replacement
  *    int *mem: array to save page no. which are in the page frame
  */
-void LRU_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile){
+int LRU_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile, int page, Prefetcher *pf, Instr *ins){
     int replace;
+    unsigned long long start;
     int fault_no = 0;
     int index;
-    printf("--LRU--\n");
-    fprintf(outfile, "--LRU--\n");
+    print_title(POL_LRU, pf, outfile);
     for(int i = 0; i < string_length; i++){
         index = in_mem(mem, page_frame, string[i]);
         // page fault
         if(index == FALSE){
+            start = ins != NULL ? instr_cycle() : 0;
             replace = LRU_replace(mem, mark, page_frame);
+            if(ins != NULL){
+                instr_replace(ins, POL_LRU, instr_cycle() - start);
+                instr_fault(ins, POL_LRU, string[i], i);
+            }
+            if(pf != NULL){
+                prefetch_evict(pf, replace, i);
+            }
             mem[replace] = string[i];
             mark[replace] = i; // mark used time
             fault_no++;
             printf("<page fault> ");
             printf("Time %d replaced index %d no. of fault %d\n", i + 1, replace, fault_no);
             fprintf(outfile, "<page fault> Time %d replaced index %d no. of fault %d\n", i + 1, replace, fault_no);
+            if(pf != NULL){
+                prefetch_load(pf, POL_LRU, mem, mark, NULL, NULL, page_frame, page, string[i], i, outfile);
+            }
         }else{
             mark[index] = i;  // mark used time
+            if(pf != NULL){
+                prefetch_hit(pf, index);
+            }
         }
         print_residence(mem, page_frame, outfile, i, 0);
     }
     printf("Total no. of fault: %d/%d\n", fault_no, string_length);
     fprintf(outfile, "Total no. of fault: %d/%d\n", fault_no, string_length);
-}
-
-/**
- * find index to be replaced following LRU algorithm
- *
- * input:
- *    int *mem: array to save page no. which are in the page frame
- *    int *mark: array that has arrival time of pages in the memory
- *    int page_frame: no. of page frame allocated, size of mem, mark
- *
- * output:
- *    return int index to be replaced(index that has minimum used time)
- */
-int LRU_replace(int *mem, int *mark, int page_frame){
-    int min = mark[0];
-    int min_no = 0;
-    for(int i = 0; i < page_frame; i++){
-        if(min > mark[i]){
-            min = mark[i];
-            min_no = i;
-        }
-    }
-    return min_no;
+    return fault_no;
 }
 
 /**
@@ -463,8 +759,12 @@ int LRU_replace(int *mem, int *mark, int page_frame){
  *    int page_frame: no. of page frame allocated, size of mem, mark
  *    int *string: array that contains reference string
  *    int string_length: size of string
+ *    int page: no. of page of the process(upper bound of prefetch)
+ *    Prefetcher *pf: prefetcher on the fault path(NULL: demand paging only)
+ *    Instr *ins: fault and replace cycle are counted(NULL: off)
  *
  * output:
+ *    return int no. of page fault
  *    print information at the console about page fault occurs
  *    FILE *outfile: print resident set, page fault data at the output file
  *
@@ -472,22 +772,34 @@ int LRU_replace(int *mem, int *mark, int page_frame){
  *    int *mark: array to save information for replacement
  *    int *mem: array to save page no. which are in the page frame
  */
-void LFU_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile){
+int LFU_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile, int page, Prefetcher *pf, Instr *ins){
     int replace;
+    unsigned long long start;
     int fault_no = 0;
     int index;
 
-    printf("--LFU--\n");
-    fprintf(outfile, "--LFU--\n");
+    print_title(POL_LFU, pf, outfile);
     // array to save used time for tie breaking
     int *tie_break = (int *)malloc(sizeof(int) * page_frame);
+    if(tie_break == NULL){
+        printf("[Error] Dynamic memory allocation failed\n");
+        exit(-3);
+    }
     mem_init(tie_break, page_frame);
 
     for(int i = 0; i < string_length; i++){
         index = in_mem(mem, page_frame, string[i]);
         // page fault
         if(index == FALSE){
+            start = ins != NULL ? instr_cycle() : 0;
             replace = LFU_replace(mem, mark, tie_break, page_frame);
+            if(ins != NULL){
+                instr_replace(ins, POL_LFU, instr_cycle() - start);
+                instr_fault(ins, POL_LFU, string[i], i);
+            }
+            if(pf != NULL){
+                prefetch_evict(pf, replace, i);
+            }
             mem[replace] = string[i];
             mark[replace] = 1;       // mark used count
             tie_break[replace] = i;  // mark used time
@@ -495,9 +807,15 @@ void LFU_test(int *mem, int *mark, int page_frame, int *string, int string_lengt
             printf("<page fault> ");
             printf("Time %d replaced index %d no. of fault %d\n", i + 1, replace, fault_no);
             fprintf(outfile, "<page fault> Time %d replaced index %d no. of fault %d\n", i + 1, replace, fault_no);
+            if(pf != NULL){
+                prefetch_load(pf, POL_LFU, mem, mark, tie_break, NULL, page_frame, page, string[i], i, outfile);
+            }
         }else{
             mark[index] += 1;        //  increase used count
             tie_break[index] = i;    //  mark used time
+            if(pf != NULL){
+                prefetch_hit(pf, index);
+            }
         }
         print_residence(mem, page_frame, outfile, i, 0);
     }
@@ -505,39 +823,7 @@ void LFU_test(int *mem, int *mark, int page_frame, int *string, int string_lengt
 
     printf("Total no. of fault: %d/%d\n", fault_no, string_length);
     fprintf(outfile, "Total no. of fault: %d/%d\n", fault_no, string_length);
-}
-
-/**
- * find index to be replaced following LFU algorithm
- *
- * input:
- *    int *mem: array to save page no. which are in the page frame
- *    int *mark: array that has used count of pages in the memory
- *    int *tie_break: array that has used time of pages in the memory
- *    int page_frame: no. of page frame allocated, size of mem, mark, tie_break
- *
- * output:
- *    return int index to be replaced(index that has minimum used count)
- */
-int LFU_replace(int *mem, int *mark, int *tie_break, int page_frame){
-    int min = mark[0];
-    int min_no = 0;
-    for(int i = 0; i < page_frame; i++){
-        if(min > mark[i]){
-            min = mark[i];
-        }
-    }
-    int tie_min = tie_break[0];
-    // if the page has same used count with minimum value, tie_break by LRU
-    for(int i = 0; i < page_frame; i++){
-        if(mark[i] == min){
-            if(tie_min > tie_break[i]){
-                tie_min = tie_break[i];
-                min_no = i;
-            }
-        }
-    }
-    return min_no;
+    return fault_no;
 }
 
 /**
@@ -551,8 +837,12 @@ int LFU_replace(int *mem, int *mark, int *tie_break, int page_frame){
  *    int page_frame: no. of page frame allocated, size of mem, mark
  *    int *string: array that contains reference string
  *    int string_length: size of string
+ *    int page: no. of page of the process(upper bound of prefetch)
+ *    Prefetcher *pf: prefetcher on the fault path(NULL: demand paging only)
+ *    Instr *ins: fault and replace cycle are counted(NULL: off)
  *
  * output:
+ *    return int no. of page fault
  *    print information at the console about page fault occurs
  *    FILE *outfile: print resident set, page fault data at the output file
  *
@@ -560,62 +850,46 @@ int LFU_replace(int *mem, int *mark, int *tie_break, int page_frame){
  *    int *mark: array to save information for replacement
  *    int *mem: array to save page no. which are in the page frame
  */
-void Clock_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile){
+int Clock_test(int *mem, int *mark, int page_frame, int *string, int string_length, FILE *outfile, int page, Prefetcher *pf, Instr *ins){
     int replace;
+    unsigned long long start;
     int fault_no = 0;
     int index;
-    printf("--Clock--\n");
-    fprintf(outfile, "--Clock--\n");
+    int needle = 0;    // clock hand, starts at frame 0 for every test
+    print_title(POL_CLOCK, pf, outfile);
     for(int i = 0; i < string_length; i++){
         index = in_mem(mem, page_frame, string[i]);
         // page fault
         if(index == FALSE){
-            replace = Clock_replace(mem, mark, page_frame);
+            start = ins != NULL ? instr_cycle() : 0;
+            replace = Clock_replace(mem, mark, page_frame, &needle);
+            if(ins != NULL){
+                instr_replace(ins, POL_CLOCK, instr_cycle() - start);
+                instr_fault(ins, POL_CLOCK, string[i], i);
+            }
+            if(pf != NULL){
+                prefetch_evict(pf, replace, i);
+            }
             mem[replace] = string[i];
             mark[replace] = 1; // reference bit = 1
             fault_no++;
             printf("<page fault> ");
             printf("Time %d replaced index %d no. of fault %d\n", i + 1, replace, fault_no);
             fprintf(outfile, "<page fault> Time %d replaced index %d no. of fault %d\n", i + 1, replace, fault_no);
+            if(pf != NULL){
+                prefetch_load(pf, POL_CLOCK, mem, mark, NULL, &needle, page_frame, page, string[i], i, outfile);
+            }
         }else{
             mark[index] = 1;   // reference bit = 1
+            if(pf != NULL){
+                prefetch_hit(pf, index);
+            }
         }
         print_residence(mem, page_frame, outfile, i, 0);
     }
     printf("Total no. of fault: %d/%d\n", fault_no, string_length);
     fprintf(outfile, "Total no. of fault: %d/%d\n", fault_no, string_length);
-}
-
-/**
- * find index to be replaced following Clock algorithm
- *
- * input:
- *    int *mem: array to save page no. which are in the page frame
- *    int *mark: array that has reference bit of pages in the memory
- *    int page_frame: no. of page frame allocated, size of mem, mark
- *
- * output:
- *    return int index to be replaced(index whose reference bit  == 0)
- */
-int Clock_replace(int *mem, int *mark, int page_frame){
-    // needle value should be hold for next search -> use static
-    static int needle = 0;
-    int replace;
-    // find page whose reference bit == 0
-    while(1){
-        if(mark[needle] == 0){
-            replace = needle;
-            needle++;
-            needle = needle % page_frame;
-            break;
-        // if reference bit == 1, change to 0 and examine next page
-        }else{
-            mark[needle] = 0;
-            needle++;
-            needle = needle % page_frame;
-        }
-    }
-    return replace;
+    return fault_no;
 }
 
 /**
@@ -629,6 +903,7 @@ int Clock_replace(int *mem, int *mark, int page_frame){
  *    int window: size of window
  *    int *string: array that contains reference string
  *    int string_length: size of string
+ *    Instr *ins: fault is counted(NULL: off)
  *
  * output:
  *    print information at the console about page fault occurs
@@ -638,7 +913,7 @@ int Clock_replace(int *mem, int *mark, int page_frame){
  *    int *page_mark: array to save used time of the page
  *                    -1 means the page is not in memory
  */
-void WS_test(int page, int window, int *page_mark, int *string, int string_length, FILE *outfile){
+void WS_test(int page, int window, int *page_mark, int *string, int string_length, FILE *outfile, Instr *ins){
     int fault_no = 0;
     int limit;
     int frame_no = 0;
@@ -655,6 +930,9 @@ void WS_test(int page, int window, int *page_mark, int *string, int string_lengt
         if(page_mark[string[i]] == -1){
             page_mark[string[i]] = i; // mark loaded time
             fault_no++;
+            if(ins != NULL){
+                instr_fault(ins, POL_WS, string[i], i);
+            }
             printf("<page fault> ");
             printf("Time %d Insert %d no. of fault %d\n", i + 1, string[i], fault_no);
             fprintf(outfile, "<page fault> Time %d Insert %d no. of fault %d\n", i + 1, string[i], fault_no);
@@ -678,54 +956,961 @@ void WS_test(int page, int window, int *page_mark, int *string, int string_lengt
 }
 
 /**
- * get input from user(maximum length: FILE_LENGTH - 1, 1 for '\0')
- *    -random: use random input and save it at rand_input.txt
- *    -file's name: open the file
+ * clear history and counter of the prefetcher before each test
+ * mode, depth are kept
  *
- * output:
- *    return FILE *infile: file pointer of input file
+ * in/output:
+ *    Prefetcher *pf: prefetcher to be initialized
  */
-FILE *get_file(void){
-    char *filename = (char *)malloc(sizeof(char) * FILE_LENGTH);
-    printf("Enter 'random'(random input) or file name to open: ");
-    scanf("%s", filename);
-
-    if(strcmp(filename, "random") == 0){
-        printf("random\n");
-        free(filename);
-        return rand_input();
-    }else{
-        FILE *infile = fopen(filename, "r");
-        if(infile == NULL){
-            printf("[Error] File opening failed\n");
-            exit(-1);
-        }
-        free(filename);
-        return infile;
+void prefetch_reset(Prefetcher *pf){
+    pf->last = -1;
+    pf->stride = 0;
+    pf->window = 0;
+    pf->ra_end = -1;
+    for(int i = 0; i < FRAME; i++){
+        pf->flag[i] = 0;
+        pf->loaded[i] = -1;
     }
+    pf->issued = 0;
+    pf->useful = 0;
+    pf->wasted = 0;
 }
 
 /**
- * create random input
- * randomly choose page, page_frame, window, string, string_length within the range
+ * choose pages to be prefetched when page 'key' faults
+ *    PF_NEXT: key + 1 ~ key + depth
+ *    PF_SEQ: if the fault continues the previous fault or readahead(sequential stream),
+ *            open window of PF_SEQ_INIT pages and double it on each sequential fault
+ *            (max depth). random fault closes the window.
+ *    PF_STRIDE: if the last two faults have same stride, key + stride * (1 ~ depth)
+ *
+ * input:
+ *    int key: page no. which caused page fault
+ *    int page: no. of page of the process(candidate should be 0 ~ page - 1)
  *
  * output:
- *    FILE *infile: file pointer that has randomly chosen values
+ *    int *candidate: page no. to be prefetched(size: depth)
+ *    return int no. of candidate
+ *
+ * in/output:
+ *    Prefetcher *pf: history of fault is updated
  */
-FILE *rand_input(void){
-    srand(time(NULL));
-    int page = rand() % PAGE + 1;
-    int page_frame = rand() % FRAME + 1;
-    int window = rand() % WINDOW + 1;
-    // range: page + 1 ~ S_LEN
-    int string_length = rand() % (S_LEN - page) + 1 + page;
+int prefetch_pages(Prefetcher *pf, int key, int page, int *candidate){
+    int n = 0;
+    int delta;
 
-    FILE *infile = fopen("rand_input.txt", "w+");
-    fprintf(infile, "%d %d %d %d\n", page, page_frame, window, string_length);
-    for(int i = 0; i < string_length; i++){
-        fprintf(infile, "%d ", rand() % page);
+    if(pf->mode == PF_NEXT){
+        for(int k = 1; k <= pf->depth && key + k < page; k++){
+            candidate[n++] = key + k;
+        }
+    }else if(pf->mode == PF_SEQ){
+        // sequential stream: previous fault page + 1 or the page right after readahead
+        if((pf->last != -1 && key == pf->last + 1) || (pf->ra_end != -1 && key == pf->ra_end + 1)){
+            if(pf->window == 0){
+                pf->window = PF_SEQ_INIT < pf->depth ? PF_SEQ_INIT : pf->depth;
+            }else{
+                pf->window = pf->window * 2 < pf->depth ? pf->window * 2 : pf->depth;
+            }
+        }else{
+            pf->window = 0;
+        }
+        for(int k = 1; k <= pf->window && key + k < page; k++){
+            candidate[n++] = key + k;
+        }
+        pf->ra_end = n > 0 ? candidate[n - 1] : -1;
+    }else if(pf->mode == PF_STRIDE && pf->last != -1){
+        // stride is known only after two faults, so first fault sets nothing
+        delta = key - pf->last;
+        if(pf->stride != 0 && delta == pf->stride){
+            for(int k = 1; k <= pf->depth; k++){
+                if((key + delta * k < 0) || (key + delta * k >= page)){
+                    break;
+                }
+                candidate[n++] = key + delta * k;
+            }
+        }
+        pf->stride = delta;
     }
-    fprintf(infile, "\n");
+    pf->last = key;
+    return n;
+}
+
+/**
+ * count useful prefetch when the prefetched page is referenced first time
+ *
+ * input:
+ *    int index: index of mem that is referenced
+ *
+ * in/output:
+ *    Prefetcher *pf: useful, flag are updated
+ */
+void prefetch_hit(Prefetcher *pf, int index){
+    if(pf->flag[index] == 1){
+        pf->useful++;
+        pf->flag[index] = 0;
+    }
+}
+
+/**
+ * count wasted prefetch when the frame is replaced before its page is referenced
+ * and remember the time the frame is filled again
+ *
+ * input:
+ *    int index: index of mem to be replaced
+ *    int time: time of the system
+ *
+ * in/output:
+ *    Prefetcher *pf: wasted, flag, loaded are updated
+ */
+void prefetch_evict(Prefetcher *pf, int index, int time){
+    if(pf->flag[index] == 1){
+        pf->wasted++;
+        pf->flag[index] = 0;
+    }
+    pf->loaded[index] = time;
+}
+
+/**
+ * bring prefetch candidates of page 'key' into mem
+ * victim is chosen by replace rule of the test, same as demand fault.
+ * prefetch stops when the rule chooses a frame filled at this fault
+ * (prefetch should not push out the faulted page or the page just prefetched)
+ *
+ * input:
+ *    int policy: POL_FIFO, POL_LRU, POL_LFU, POL_CLOCK
+ *    int page_frame: no. of page frame allocated, size of mem, mark
+ *    int page: no. of page of the process
+ *    int key: page no. which caused page fault
+ *    int time: time of the system, same as index of string
+ *
+ * output:
+ *    print information at the console about prefetch
+ *    FILE *outfile: print prefetch data at the output file
+ *
+ * in/output:
+ *    Prefetcher *pf: state of the prefetcher
+ *    int *mem: array to save page no. which are in the page frame
+ *    int *mark: array to save information for replacement
+ *    int *tie_break: used time of pages(LFU only, NULL otherwise)
+ *    int *needle: clock hand(Clock only, NULL otherwise)
+ */
+void prefetch_load(Prefetcher *pf, int policy, int *mem, int *mark, int *tie_break, int *needle,
+                   int page_frame, int page, int key, int time, FILE *outfile){
+    int candidate[FRAME];
+    int n = prefetch_pages(pf, key, page, candidate);
+    int replace;
+
+    for(int k = 0; k < n; k++){
+        if(in_mem(mem, page_frame, candidate[k]) != FALSE){
+            continue;
+        }
+        replace = select_victim(policy, mem, mark, tie_break, page_frame, needle);
+        if(pf->loaded[replace] == time){
+            break;
+        }
+        prefetch_evict(pf, replace, time);
+        mem[replace] = candidate[k];
+        pf->flag[replace] = 1;
+        pf->issued++;
+
+        // prefetched page is loaded like faulted page, but it is not referenced yet
+        mark_use(policy, mark, tie_break, replace, time, 1);
+        if(policy == POL_CLOCK){
+            mark[replace] = 0;        // reference bit = 0
+        }
+        printf("<prefetch> Time %d Insert %d replaced index %d\n", time + 1, candidate[k], replace);
+        fprintf(outfile, "<prefetch> Time %d Insert %d replaced index %d\n", time + 1, candidate[k], replace);
+    }
+}
+
+/**
+ * print prefetch result of the test compared with demand paging
+ * prefetched page which is still not referenced at the end is counted as wasted
+ *
+ * input:
+ *    int policy: POL_* of the test
+ *    int fault_demand: no. of fault without prefetch
+ *    int fault_prefetch: no. of fault with prefetch
+ *
+ * output:
+ *    print prefetch result at the console and output file
+ *    FILE *outfile: pointer of output file
+ *
+ * in/output:
+ *    Prefetcher *pf: wasted is updated
+ */
+void prefetch_report(Prefetcher *pf, int policy, int fault_demand, int fault_prefetch, FILE *outfile){
+    for(int i = 0; i < FRAME; i++){
+        if(pf->flag[i] == 1){
+            pf->wasted++;
+            pf->flag[i] = 0;
+        }
+    }
+    double reduction = fault_demand == 0 ? 0 : 100.0 * (fault_demand - fault_prefetch) / fault_demand;
+    printf("%s prefetch: issued %d useful %d wasted %d, fault %d -> %d (%.2lf%% reduced)\n",
+           policy_name[policy], pf->issued, pf->useful, pf->wasted, fault_demand, fault_prefetch, reduction);
+    fprintf(outfile, "%s prefetch: issued %d useful %d wasted %d, fault %d -> %d (%.2lf%% reduced)\n",
+            policy_name[policy], pf->issued, pf->useful, pf->wasted, fault_demand, fault_prefetch, reduction);
+}
+
+/**
+ * create arrays of the shared frame pool
+ * call multi-process test function for each frame allocation
+ *
+ * input:
+ *    Process *proc: processes to be interleaved(size: proc_no)
+ *    int quantum: no. of reference a process runs before the next process
+ *    int pool_size: no. of page frame shared by all processes
+ *
+ * output:
+ *    print no. of fault and thrashing of each process for each allocation
+ *    FILE *outfile: pointer of output file
+ */
+void MP_Test(Process *proc, int proc_no, int quantum, int pool_size, FILE *outfile){
+    int total;
+    for(int mode = MP_GLOBAL_LRU; mode <= MP_WS; mode++){
+        printf("--MP %s--\n", mp_name[mode]);
+        fprintf(outfile, "--MP %s--\n", mp_name[mode]);
+
+        // local allocation needs every process's frames at once
+        if(mode == MP_LOCAL){
+            total = 0;
+            for(int i = 0; i < proc_no; i++){
+                total += proc[i].page_frame;
+                if(proc[i].page_frame < 1){
+                    total = -1;
+                    break;
+                }
+            }
+            if(total == -1){
+                printf("[Error] page frame of process should be at least 1 for local allocation, skipped\n");
+                fprintf(outfile, "[Error] page frame of process should be at least 1 for local allocation, skipped\n");
+                continue;
+            }
+            if(total > pool_size){
+                printf("[Error] sum of page frame of process(%d) is bigger than pool(%d), skipped\n", total, pool_size);
+                fprintf(outfile, "[Error] sum of page frame of process(%d) is bigger than pool(%d), skipped\n", total, pool_size);
+                continue;
+            }
+        }
+        MP_run(mode, proc, proc_no, quantum, pool_size, outfile);
+    }
+}
+
+/**
+ * Test function of multi-process mode
+ * processes are scheduled round robin, each runs 'quantum' references per turn
+ * check if (pid, page) is in the pool
+ * if page fault occurs, find pool's index to be replaced following 'mode'
+ *
+ * Rule:
+ *    MP_GLOBAL_LRU: replace least recently used frame of the whole pool
+ *    MP_GLOBAL_CLOCK: replace frame whose reference bit is 0, one needle for the pool
+ *    MP_LOCAL: each process has page_frame frames, replace its own LRU frame
+ *    MP_PFF: if virtual time since the last fault > window, release own frames
+ *            not referenced since the last fault, else the process grows
+ *    MP_WS: own pages out of window are released, a process is admitted only if
+ *           its working set fits in free frames, and swapped out when memory is short
+ *
+ * input:
+ *    int mode: MP_GLOBAL_LRU, MP_GLOBAL_CLOCK, MP_LOCAL, MP_PFF, MP_WS
+ *    int proc_no: no. of process, size of proc
+ *    int quantum: no. of reference a process runs before the next process
+ *    int pool_size: no. of page frame shared by all processes
+ *
+ * output:
+ *    return int total no. of fault
+ *    FILE *outfile: print page fault data, result of each process at the output file
+ *    print result of each process at the console
+ *
+ * in/output:
+ *    Process *proc: counters of each process are initialized and updated
+ */
+int MP_run(int mode, Process *proc, int proc_no, int quantum, int pool_size, FILE *outfile){
+    /*
+     * int pool_pid[i]: process which has frame i(-1: free)
+     * int pool_page[i]: page no. in frame i
+     * int pool_mark[i]: global used time(LRU) or reference bit(Clock) of frame i
+     * int pool_use[i]: 1 if frame i is referenced since the last fault of the owner(PFF)
+     */
+    int pool_pid[POOL], pool_page[POOL], pool_mark[POOL], pool_use[POOL];
+    int needle = 0;
+    int time = 0;
+    int total_fault = 0;
+    int finished = 0;
+    int index, replace, key, fault, ref, limit, ws_sum, active_no;
+    Process *p;
+
+    mem_init(pool_pid, pool_size);
+    mem_init(pool_page, pool_size);
+    mem_init(pool_mark, pool_size);
+    mem_init(pool_use, pool_size);
+    for(int i = 0; i < proc_no; i++){
+        proc[i].pos = 0;
+        proc[i].fault = 0;
+        proc[i].resident = 0;
+        proc[i].last_fault = 0;
+        mem_init(proc[i].last_use, proc[i].page);
+        proc[i].active = mode == MP_WS ? 0 : 1;
+        proc[i].ws_estimate = proc[i].page_frame;
+        proc[i].suspend = 0;
+        proc[i].quanta = 0;
+        proc[i].thrash = 0;
+    }
+
+    while(finished < proc_no){
+        finished = 0;
+        for(int pid = 0; pid < proc_no; pid++){
+            p = &proc[pid];
+            if(p->pos >= p->string_length){
+                finished++;
+                continue;
+            }
+
+            // WS admission control: working set of the process should fit in the pool
+            // resident set size when swapped out(page_frame at first) is the estimate
+            if(mode == MP_WS && p->active == 0){
+                ws_sum = 0;
+                active_no = 0;
+                for(int i = 0; i < proc_no; i++){
+                    if(proc[i].active == 1){
+                        ws_sum += proc[i].resident;
+                        active_no++;
+                    }
+                }
+                if(ws_sum + p->ws_estimate > pool_size && active_no > 0){
+                    continue;
+                }
+                p->active = 1;
+            }
+
+            // run one quantum
+            fault = 0;
+            ref = 0;
+            while(ref < quantum && p->pos < p->string_length){
+                key = p->string[p->pos];
+                index = MP_find(pool_pid, pool_page, pool_size, pid, key);
+                if(index == FALSE){
+                    // PFF: long inter-fault time -> release frames not used since the last fault
+                    if(mode == MP_PFF){
+                        if(p->pos - p->last_fault > p->window){
+                            for(int i = 0; i < pool_size; i++){
+                                if(pool_pid[i] == pid && pool_use[i] == 0){
+                                    MP_evict(proc, pool_pid, pool_page, pool_mark, i);
+                                }
+                            }
+                        }
+                        for(int i = 0; i < pool_size; i++){
+                            if(pool_pid[i] == pid){
+                                pool_use[i] = 0;
+                            }
+                        }
+                        p->last_fault = p->pos;
+                    }
+                    replace = MP_replace(mode, proc, proc_no, pid, pool_pid, pool_page, pool_mark, pool_size,
+                                         &needle, outfile, time);
+                    if(pool_pid[replace] != -1){
+                        MP_evict(proc, pool_pid, pool_page, pool_mark, replace);
+                    }
+                    pool_pid[replace] = pid;
+                    pool_page[replace] = key;
+                    p->resident++;
+                    p->fault++;
+                    fault++;
+                    total_fault++;
+                    index = replace;
+                    fprintf(outfile, "<page fault> Time %d P%d page %d replaced frame %d\n", time + 1, pid, key, replace);
+                }
+                pool_mark[index] = mode == MP_GLOBAL_CLOCK ? 1 : time;  // reference bit or used time
+                pool_use[index] = 1;
+                p->last_use[key] = p->pos;
+
+                // WS: release own pages out of window
+                if(mode == MP_WS){
+                    limit = p->pos - p->window;
+                    for(int i = 0; i < pool_size; i++){
+                        if(pool_pid[i] == pid && limit > p->last_use[pool_page[i]]){
+                            MP_evict(proc, pool_pid, pool_page, pool_mark, i);
+                        }
+                    }
+                }
+                p->pos++;
+                ref++;
+                time++;
+            }
+
+            if(ref > 0){
+                p->quanta++;
+                if(fault > THRASH_RATE * ref){
+                    p->thrash++;
+                }
+            }
+
+            // process exit: frames go back to the pool
+            if(p->pos >= p->string_length){
+                for(int i = 0; i < pool_size; i++){
+                    if(pool_pid[i] == pid){
+                        MP_evict(proc, pool_pid, pool_page, pool_mark, i);
+                    }
+                }
+                p->active = 0;
+            }
+        }
+    }
+
+    // result of each process
+    // a process is thrashing if more than half of its quanta are over THRASH_RATE
+    for(int pid = 0; pid < proc_no; pid++){
+        p = &proc[pid];
+        printf("P%d fault %d/%d (%.2lf%%) thrashing quantum %d/%d", pid, p->fault, p->string_length,
+               100.0 * p->fault / p->string_length, p->thrash, p->quanta);
+        fprintf(outfile, "P%d fault %d/%d (%.2lf%%) thrashing quantum %d/%d", pid, p->fault, p->string_length,
+                100.0 * p->fault / p->string_length, p->thrash, p->quanta);
+        if(mode == MP_WS){
+            printf(" swapped out %d", p->suspend);
+            fprintf(outfile, " swapped out %d", p->suspend);
+        }
+        if(p->thrash * 2 > p->quanta){
+            printf(" [Thrashing]");
+            fprintf(outfile, " [Thrashing]");
+        }
+        printf("\n");
+        fprintf(outfile, "\n");
+    }
+    printf("Total no. of fault: %d/%d\n", total_fault, time);
+    fprintf(outfile, "Total no. of fault: %d/%d\n", total_fault, time);
+    return total_fault;
+}
+
+/**
+ * check if page 'key' of process 'pid' is in the pool (using linear search)
+ *
+ * input:
+ *    int *pool_pid: owner process of each frame
+ *    int *pool_page: page no. of each frame
+ *    int pool_size: size of the pool
+ *    int pid, key: process and page to be found
+ *
+ * output:
+ *    return int index of the pool(if found)
+ *           int FALSE(-1) (if search failed)
+ */
+int MP_find(int *pool_pid, int *pool_page, int pool_size, int pid, int key){
+    for(int i = 0; i < pool_size; i++){
+        if(pool_pid[i] == pid && pool_page[i] == key){
+            return i;
+        }
+    }
+    return FALSE;
+}
+
+/**
+ * find pool's index to be replaced when process 'pid' faults
+ * free frame is used first except for MP_LOCAL whose process already has page_frame frames
+ *
+ * input:
+ *    int mode: MP_GLOBAL_LRU, MP_GLOBAL_CLOCK, MP_LOCAL, MP_PFF, MP_WS
+ *    int proc_no: no. of process, size of proc
+ *    int pid: process which faulted
+ *    int pool_size: size of the pool
+ *    int time: time of the system
+ *
+ * output:
+ *    return int index to be replaced
+ *    FILE *outfile: print swap out of WS at the output file
+ *
+ * in/output:
+ *    Process *proc: WS may swap out another process(active, suspend are updated)
+ *    int *pool_pid, *pool_page: frames of swapped out process are freed(WS)
+ *    int *pool_mark: used time(LRU) or reference bit(Clock) of each frame
+ *    int *needle: clock hand of MP_GLOBAL_CLOCK
+ */
+int MP_replace(int mode, Process *proc, int proc_no, int pid, int *pool_pid, int *pool_page, int *pool_mark,
+               int pool_size, int *needle, FILE *outfile, int time){
+    int replace = FALSE;
+    int min = 0;
+
+    // free frame first if the process can grow
+    // (Clock_replace treats mark -1 of free frame as reference bit, so it is not left to the rule)
+    if(mode != MP_LOCAL || proc[pid].resident < proc[pid].page_frame){
+        replace = in_mem(pool_pid, pool_size, -1);
+        if(replace != FALSE){
+            return replace;
+        }
+    }
+
+    // global replacement follows single process rule over the whole pool
+    if(mode == MP_GLOBAL_LRU){
+        return LRU_replace(pool_pid, pool_mark, pool_size);
+    }
+    if(mode == MP_GLOBAL_CLOCK){
+        return Clock_replace(pool_pid, pool_mark, pool_size, needle);
+    }
+
+    // WS: memory is short -> swap out the other active process with the largest resident set
+    if(mode == MP_WS){
+        int out = FALSE;
+        for(int i = 0; i < proc_no; i++){
+            if(i != pid && proc[i].active == 1 && proc[i].resident > 0
+               && (out == FALSE || proc[i].resident > proc[out].resident)){
+                out = i;
+            }
+        }
+        if(out != FALSE){
+            // remember resident set size as working set estimate for admission
+            proc[out].ws_estimate = proc[out].resident;
+            for(int i = 0; i < pool_size; i++){
+                if(pool_pid[i] == out){
+                    MP_evict(proc, pool_pid, pool_page, pool_mark, i);
+                    if(replace == FALSE){
+                        replace = i;
+                    }
+                }
+            }
+            proc[out].active = 0;
+            proc[out].suspend++;
+            fprintf(outfile, "<swap out> Time %d P%d\n", time + 1, out);
+            return replace;
+        }
+    }
+
+    // own least recently used frame
+    for(int i = 0; i < pool_size; i++){
+        if(pool_pid[i] == pid && (replace == FALSE || pool_mark[i] < min)){
+            min = pool_mark[i];
+            replace = i;
+        }
+    }
+    // process has no frame and no free frame(PFF): global LRU
+    if(replace == FALSE){
+        replace = LRU_replace(pool_pid, pool_mark, pool_size);
+    }
+    return replace;
+}
+
+/**
+ * release frame 'index' from its owner process
+ *
+ * input:
+ *    int index: index of the pool to be released
+ *
+ * in/output:
+ *    Process *proc: resident of the owner is decreased
+ *    int *pool_pid, *pool_page, *pool_mark: frame is marked free(-1)
+ */
+void MP_evict(Process *proc, int *pool_pid, int *pool_page, int *pool_mark, int index){
+    proc[pool_pid[index]].resident--;
+    pool_pid[index] = -1;
+    pool_page[index] = -1;
+    pool_mark[index] = -1;
+}
+
+/**
+ * call tiered memory test function for LRU, LFU, Clock
+ * DRAM has page_frame frames, slow tier has option->slow_frame frames, swap is unlimited
+ *
+ * input:
+ *    int page_frame: no. of page frame of DRAM
+ *    int *string: array that contains reference string
+ *    int string_length: size of string
+ *    Option *option: slow_frame, promote, latency
+ *
+ * output:
+ *    print per tier hit and modeled average access latency of each algorithm
+ *    FILE *outfile: pointer of output file
+ */
+void Tier_Test(int page_frame, int *string, int string_length, Option *option, FILE *outfile){
+    Tier dram, slow;
+    int policy[3] = {POL_LRU, POL_LFU, POL_CLOCK};
+
+    for(int k = 0; k < 3; k++){
+        dram.size = page_frame;
+        dram.latency = option->latency[0];
+        slow.size = option->slow_frame;
+        slow.latency = option->latency[1];
+        printf("--Tier %s (DRAM %d, slow %d, promote %d)--\n", policy_name[policy[k]], dram.size, slow.size, option->promote);
+        fprintf(outfile, "--Tier %s (DRAM %d, slow %d, promote %d)--\n", policy_name[policy[k]], dram.size, slow.size, option->promote);
+        Tier_run(policy[k], &dram, &slow, option->promote, option->latency[2], string, string_length, outfile);
+    }
+}
+
+/**
+ * Test function of tiered memory
+ * check if the page no. is in DRAM, and then in slow tier
+ * Rule:
+ *    DRAM hit: page is referenced in DRAM
+ *    slow hit: page is referenced in slow tier, and promoted to DRAM after 'promote' access
+ *    fault: page is swapped in to DRAM
+ *    page pushed out of DRAM is demoted to slow tier, page pushed out of slow tier goes to swap.
+ *    victim of each tier is chosen by replace rule of 'policy'
+ *
+ * input:
+ *    int policy: POL_LRU, POL_LFU, POL_CLOCK
+ *    int promote: no. of access in slow tier to be promoted
+ *    int swap_ns: latency of swap in(ns)
+ *    int *string: array that contains reference string
+ *    int string_length: size of string
+ *
+ * output:
+ *    return int no. of page fault(swap in)
+ *    print per tier hit, migration and average latency at the console
+ *    FILE *outfile: print page fault, promotion, demotion data at the output file
+ *
+ * in/output:
+ *    Tier *dram, *slow: size, latency are input, frames and hit are initialized and updated
+ */
+int Tier_run(int policy, Tier *dram, Tier *slow, int promote, int swap_ns, int *string, int string_length, FILE *outfile){
+    int fault_no = 0;
+    int promotion = 0, demotion = 0, swap_out = 0;
+    double latency = 0;
+    int index, victim;
+
+    mem_init(dram->mem, dram->size);
+    mem_init(dram->mark, dram->size);
+    mem_init(dram->tie_break, dram->size);
+    mem_init(slow->mem, slow->size);
+    mem_init(slow->mark, slow->size);
+    mem_init(slow->tie_break, slow->size);
+    dram->needle = slow->needle = 0;
+    dram->hit = slow->hit = 0;
+
+    for(int i = 0; i < string_length; i++){
+        // DRAM hit
+        index = in_mem(dram->mem, dram->size, string[i]);
+        if(index != FALSE){
+            mark_use(policy, dram->mark, dram->tie_break, index, i, 0);
+            dram->hit++;
+            latency += dram->latency;
+            continue;
+        }
+
+        // slow tier hit: served from slow tier, promoted when accessed enough
+        index = in_mem(slow->mem, slow->size, string[i]);
+        if(index != FALSE){
+            mark_use(policy, slow->mark, slow->tie_break, index, i, 0);
+            slow->hit++;
+            latency += slow->latency;
+            slow->access[index]++;
+            if(slow->access[index] < promote){
+                continue;
+            }
+            // promote: the page leaves slow tier, so DRAM victim can take its frame
+            slow->mem[index] = -1;
+            slow->mark[index] = -1;
+            slow->tie_break[index] = -1;
+            promotion++;
+            fprintf(outfile, "<promote> Time %d page %d\n", i + 1, string[i]);
+        }else{
+            fault_no++;
+            latency += swap_ns;
+            fprintf(outfile, "<page fault> Time %d page %d no. of fault %d\n", i + 1, string[i], fault_no);
+        }
+
+        // bring the page into DRAM, demote DRAM victim to slow tier
+        victim = Tier_insert(policy, dram, string[i], i);
+        if(victim != -1 && slow->size > 0){
+            demotion++;
+            fprintf(outfile, "<demote> Time %d page %d\n", i + 1, victim);
+            victim = Tier_insert(policy, slow, victim, i);
+        }
+        if(victim != -1){
+            swap_out++;
+            fprintf(outfile, "<swap out> Time %d page %d\n", i + 1, victim);
+        }
+    }
+
+    printf("DRAM hit %d slow hit %d swap in %d (%s %.2lf%% %s %.2lf%% %s %.2lf%%)\n",
+           dram->hit, slow->hit, fault_no, tier_name[0], 100.0 * dram->hit / string_length,
+           tier_name[1], 100.0 * slow->hit / string_length, tier_name[2], 100.0 * fault_no / string_length);
+    fprintf(outfile, "DRAM hit %d slow hit %d swap in %d (%s %.2lf%% %s %.2lf%% %s %.2lf%%)\n",
+            dram->hit, slow->hit, fault_no, tier_name[0], 100.0 * dram->hit / string_length,
+            tier_name[1], 100.0 * slow->hit / string_length, tier_name[2], 100.0 * fault_no / string_length);
+    printf("promotion %d demotion %d swap out %d\n", promotion, demotion, swap_out);
+    fprintf(outfile, "promotion %d demotion %d swap out %d\n", promotion, demotion, swap_out);
+    printf("average access latency: %.2lf ns\n", latency / string_length);
+    fprintf(outfile, "average access latency: %.2lf ns\n", latency / string_length);
+    printf("Total no. of fault: %d/%d\n", fault_no, string_length);
+    fprintf(outfile, "Total no. of fault: %d/%d\n", fault_no, string_length);
+    return fault_no;
+}
+
+/**
+ * put page 'key' into the tier
+ * free frame is used first, otherwise victim of replace rule is pushed out
+ *
+ * input:
+ *    int policy: POL_LRU, POL_LFU, POL_CLOCK
+ *    int key: page no. to be inserted
+ *    int time: time of the system
+ *
+ * output:
+ *    return int page no. pushed out of the tier(-1: free frame was used)
+ *
+ * in/output:
+ *    Tier *tier: frames of the tier
+ */
+int Tier_insert(int policy, Tier *tier, int key, int time){
+    int replace = in_mem(tier->mem, tier->size, -1);
+    if(replace == FALSE){
+        replace = select_victim(policy, tier->mem, tier->mark, tier->tie_break, tier->size, &tier->needle);
+    }
+    int victim = tier->mem[replace];
+    tier->mem[replace] = key;
+    tier->access[replace] = 0;
+    mark_use(policy, tier->mark, tier->tie_break, replace, time, 1);
+    return victim;
+}
+
+/**
+ * call compressed pool test function for LRU, LFU, Clock
+ *
+ * input:
+ *    int page: no. of page of the process, size of ratio
+ *    int page_frame: no. of resident page frame
+ *    int *string: array that contains reference string
+ *    int string_length: size of string
+ *    double *ratio: compression ratio of each page
+ *    Option *option: pool_byte, latency[2](swap)
+ *
+ * output:
+ *    print pool hit, capacity gain, CPU cost and I/O saved of each algorithm
+ *    FILE *outfile: pointer of output file
+ */
+void Zswap_Test(int page, int page_frame, int *string, int string_length, double *ratio, Option *option, FILE *outfile){
+    int policy[3] = {POL_LRU, POL_LFU, POL_CLOCK};
+    double sum = 0;
+    for(int i = 0; i < page; i++){
+        sum += ratio[i];
+    }
+    for(int k = 0; k < 3; k++){
+        printf("--Zswap %s (frame %d, pool %ld byte, average ratio %.2lf)--\n",
+               policy_name[policy[k]], page_frame, option->pool_byte, sum / page);
+        fprintf(outfile, "--Zswap %s (frame %d, pool %ld byte, average ratio %.2lf)--\n",
+                policy_name[policy[k]], page_frame, option->pool_byte, sum / page);
+        Zswap_run(policy[k], page, page_frame, string, string_length, ratio, option->pool_byte, option->latency[2], outfile);
+    }
+}
+
+/**
+ * Test function of compressed memory pool
+ * resident frames follow the replace rule of 'policy'
+ * Rule:
+ *    page evicted from frames is compressed into the pool(PAGE_SIZE / ratio byte).
+ *    if it does not shrink(ratio <= 1) or is bigger than the pool, it is written to swap.
+ *    when the pool is full, the oldest stored page is written back to swap.
+ *    fault on a page in the pool is served by decompression(the entry leaves the pool),
+ *    fault on a page evicted before is served by swap in, first touch costs nothing.
+ *    without the pool, every eviction is a swap out and every refault is a swap in.
+ *
+ * input:
+ *    int policy: POL_LRU, POL_LFU, POL_CLOCK
+ *    int page: no. of page of the process
+ *    int page_frame: no. of resident page frame
+ *    int *string: array that contains reference string
+ *    int string_length: size of string
+ *    double *ratio: compression ratio of each page
+ *    long pool_byte: capacity of the pool
+ *    int swap_ns: latency of swap in / out(ns)
+ *
+ * output:
+ *    return int no. of page fault
+ *    print pool hit rate, capacity gain, CPU cost and I/O saved at the console
+ *    FILE *outfile: print page fault, pool data at the output file
+ */
+int Zswap_run(int policy, int page, int page_frame, int *string, int string_length, double *ratio,
+              long pool_byte, int swap_ns, FILE *outfile){
+    /*
+     * int stored[j]: compressed size of page j in the pool(0: not in the pool)
+     * int stored_time[j]: time page j was stored(for write back of the oldest)
+     * int evicted[j]: 1 if page j was evicted before(refault needs swap in)
+     */
+    int mem[FRAME], mark[FRAME], tie_break[FRAME];
+    int stored[PAGE], stored_time[PAGE], evicted[PAGE];
+    int needle = 0;
+    long pool_used = 0;
+    double pool_page_sum = 0;   // sum of no. of page in the pool over time
+    double pool_byte_sum = 0;   // sum of used byte of the pool over time
+    double gain_sum = 0;        // sum of page held / raw page used, while the pool is not empty
+    int gain_sample = 0;
+    int fault_no = 0, refault = 0, pool_hit = 0, store = 0, reject = 0;
+    int swap_in = 0, swap_out = 0, writeback = 0, eviction = 0;
+    int index, replace, victim, size, oldest, pool_page = 0;
+
+    mem_init(mem, page_frame);
+    mem_init(mark, page_frame);
+    mem_init(tie_break, page_frame);
+    for(int j = 0; j < page; j++){
+        stored[j] = 0;
+        stored_time[j] = -1;
+        evicted[j] = 0;
+    }
+
+    for(int i = 0; i < string_length; i++){
+        index = in_mem(mem, page_frame, string[i]);
+        if(index != FALSE){
+            mark_use(policy, mark, tie_break, index, i, 0);
+            Zswap_sample(pool_page, pool_used, &pool_page_sum, &pool_byte_sum, &gain_sum, &gain_sample);
+            continue;
+        }
+
+        // page fault: pool -> decompress, evicted before -> swap in
+        fault_no++;
+        if(evicted[string[i]] == 1){
+            refault++;
+        }
+        if(stored[string[i]] > 0){
+            pool_hit++;
+            pool_used -= stored[string[i]];
+            stored[string[i]] = 0;
+            pool_page--;
+            fprintf(outfile, "<pool hit> Time %d page %d\n", i + 1, string[i]);
+        }else if(evicted[string[i]] == 1){
+            swap_in++;
+            fprintf(outfile, "<page fault> Time %d page %d swap in\n", i + 1, string[i]);
+        }else{
+            fprintf(outfile, "<page fault> Time %d page %d first touch\n", i + 1, string[i]);
+        }
+
+        replace = in_mem(mem, page_frame, -1);
+        if(replace == FALSE){
+            replace = select_victim(policy, mem, mark, tie_break, page_frame, &needle);
+        }
+        victim = mem[replace];
+        mem[replace] = string[i];
+        mark_use(policy, mark, tie_break, replace, i, 1);
+
+        // evicted page goes to the pool, or to swap if it does not fit
+        if(victim != -1){
+            eviction++;
+            evicted[victim] = 1;
+            size = (int)(PAGE_SIZE / ratio[victim]);
+            if(size >= PAGE_SIZE || size > pool_byte){
+                reject++;
+                swap_out++;
+            }else{
+                // write back the oldest page until the new page fits
+                while(pool_used + size > pool_byte){
+                    oldest = FALSE;
+                    for(int j = 0; j < page; j++){
+                        if(stored[j] > 0 && (oldest == FALSE || stored_time[j] < stored_time[oldest])){
+                            oldest = j;
+                        }
+                    }
+                    pool_used -= stored[oldest];
+                    stored[oldest] = 0;
+                    pool_page--;
+                    writeback++;
+                    swap_out++;
+                    fprintf(outfile, "<write back> Time %d page %d\n", i + 1, oldest);
+                }
+                stored[victim] = size;
+                stored_time[victim] = i;
+                pool_used += size;
+                pool_page++;
+                store++;
+            }
+        }
+        Zswap_sample(pool_page, pool_used, &pool_page_sum, &pool_byte_sum, &gain_sum, &gain_sample);
+    }
+
+    // cost: compression on store, decompression on pool hit
+    // saved: swap in of pool hit, swap out of page which stayed in the pool
+    double cpu_ns = (double)store * COMP_NS + (double)pool_hit * DECOMP_NS;
+    double io_saved_ns = (double)(refault - swap_in) * swap_ns + (double)(eviction - swap_out) * swap_ns;
+    double pool_avg = pool_page_sum / string_length;
+    double gain = gain_sample == 0 ? 0 : gain_sum / gain_sample;
+    double occupancy = pool_byte == 0 ? 0 : 100.0 * pool_byte_sum / string_length / pool_byte;
+
+    printf("pool hit %d/%d refault (%.2lf%%) store %d reject %d write back %d\n",
+           pool_hit, refault, refault == 0 ? 0 : 100.0 * pool_hit / refault, store, reject, writeback);
+    fprintf(outfile, "pool hit %d/%d refault (%.2lf%%) store %d reject %d write back %d\n",
+            pool_hit, refault, refault == 0 ? 0 : 100.0 * pool_hit / refault, store, reject, writeback);
+    printf("swap in %d (%d without pool) swap out %d (%d without pool)\n", swap_in, refault, swap_out, eviction);
+    fprintf(outfile, "swap in %d (%d without pool) swap out %d (%d without pool)\n", swap_in, refault, swap_out, eviction);
+    printf("average page in pool %.2lf, capacity gain %.2lfx, occupancy %.2lf%% of %ld byte\n",
+           pool_avg, gain, occupancy, pool_byte);
+    fprintf(outfile, "average page in pool %.2lf, capacity gain %.2lfx, occupancy %.2lf%% of %ld byte\n",
+            pool_avg, gain, occupancy, pool_byte);
+    printf("CPU cost %.0lf ns, I/O saved %.0lf ns, net %.0lf ns\n", cpu_ns, io_saved_ns, io_saved_ns - cpu_ns);
+    fprintf(outfile, "CPU cost %.0lf ns, I/O saved %.0lf ns, net %.0lf ns\n", cpu_ns, io_saved_ns, io_saved_ns - cpu_ns);
+    printf("Total no. of fault: %d/%d\n", fault_no, string_length);
+    fprintf(outfile, "Total no. of fault: %d/%d\n", fault_no, string_length);
+    return fault_no;
+}
+
+/**
+ * add pool state of one reference to the sums of Zswap_run
+ * capacity gain is page held / raw page the held bytes would fill(pool_used / PAGE_SIZE),
+ * sampled only while the pool is not empty
+ *
+ * input:
+ *    int pool_page: no. of page in the pool
+ *    long pool_used: used byte of the pool
+ *
+ * in/output:
+ *    double *pool_page_sum, *pool_byte_sum: sum of no. of page, used byte over time
+ *    double *gain_sum: sum of capacity gain
+ *    int *gain_sample: no. of sample of gain_sum
+ */
+void Zswap_sample(int pool_page, long pool_used, double *pool_page_sum, double *pool_byte_sum,
+                  double *gain_sum, int *gain_sample){
+    *pool_page_sum += pool_page;
+    *pool_byte_sum += pool_used;
+    if(pool_page > 0 && pool_used > 0){
+        *gain_sum += (double)pool_page * PAGE_SIZE / pool_used;
+        (*gain_sample)++;
+    }
+}
+
+/**
+ * get input from user(maximum length: FILE_LENGTH - 1, 1 for '\0')
+ *    -random: use random input and save it at rand_input.txt
+ *    -file's name: open the file
+ *
+ * output:
+ *    return FILE *infile: file pointer of input file
+ */
+FILE *get_file(void){
+    char *filename = (char *)malloc(sizeof(char) * FILE_LENGTH);
+    printf("Enter 'random'(random input) or file name to open: ");
+    scanf("%s", filename);
+
+    if(strcmp(filename, "random") == 0){
+        printf("random\n");
+        free(filename);
+        return rand_input();
+    }else{
+        FILE *infile = fopen(filename, "r");
+        if(infile == NULL){
+            printf("[Error] File opening failed\n");
+            exit(-1);
+        }
+        free(filename);
+        return infile;
+    }
+}
+
+/**
+ * create random input
+ * randomly choose page, page_frame, window, string, string_length within the range
+ *
+ * output:
+ *    FILE *infile: file pointer that has randomly chosen values
+ */
+FILE *rand_input(void){
+    srand(time(NULL));
+    int page = rand() % PAGE + 1;
+    int page_frame = rand() % FRAME + 1;
+    int window = rand() % WINDOW + 1;
+    // range: page + 1 ~ S_LEN
+    int string_length = rand() % (S_LEN - page) + 1 + page;
+
+    FILE *infile = fopen("rand_input.txt", "w+");
+    fprintf(infile, "%d %d %d %d\n", page, page_frame, window, string_length);
+    for(int i = 0; i < string_length; i++){
+        fprintf(infile, "%d ", rand() % page);
+    }
+    fprintf(infile, "\n");
 
     // set file pointer to the start
     fseek(infile, 0, SEEK_SET);
@@ -762,36 +1947,64 @@ int *get_data(FILE *infile, int *page, int *page_frame, int *window, int *string
         printf("[Error]The range of window size: 0~ 100\n");
         exit(-2);
     }
-    if((*string_length > S_LEN) || (*string_length < 0)){
+    // mapped file is parsed by threads, so S_LEN is applied to fscanf input only
+    // string longer than S_LEN should fit in the rest of the file(at least 2 byte per reference)
+    long remain = parse_remain(infile);
+    if((*string_length > S_LEN && (remain < 0 || *string_length > (remain + 1) / 2)) || (*string_length < 0)){
         printf("[Error]The range of length of string: 0~ 100000\n");
         exit(-2);
     }
 
-    int *string = (int *)malloc(sizeof(int) * (*string_length));
+    int *string = (int *)calloc(*string_length > 0 ? *string_length : 1, sizeof(int));
     if(string == NULL){
         printf("[Error] Dynamic memory allocation failed\n");
         exit(-3);
     }
 
     // get reference string and save to string[i]
-    int cnt = 0;
-    for(int i = 0; i < (*string_length); i++){
-        cnt += fscanf(infile, "%d ", &(string[i]));
-        printf("%d ", string[i]);
+    // mapped file is parsed by several threads with range check(vm_parse.c)
+    int result = parse_file(infile, string, *string_length, *page);
+    if(result == PARSE_ERR_ALLOC){
+        printf("[Error] Dynamic memory allocation failed\n");
+        exit(-3);
+    }
+    if(result == PARSE_ERR_MAP){
+        if(*string_length > S_LEN){
+            printf("[Error]The range of length of string: 0~ 100000\n");
+            exit(-2);
+        }
+        int cnt = 0;
+        for(int i = 0; i < (*string_length); i++){
+            cnt += fscanf(infile, "%d ", &(string[i]));
+        }
+        result = PARSE_OK;
+        if(cnt != (*string_length)){
+            result = PARSE_ERR_COUNT;
+        }else if(find_min(string, *string_length) < 0){
+            result = PARSE_ERR_MIN;
+        }else if(find_max(string, *string_length) > (*page - 1)){
+            result = PARSE_ERR_MAX;
+        }
+    }
+    if(*string_length <= ECHO_LEN){
+        for(int i = 0; i < (*string_length); i++){
+            printf("%d ", string[i]);
+        }
+        printf("\n");
+    }else{
+        printf("(%d references, not printed)\n", *string_length);
     }
-    printf("\n");
 
     // file format check
-    if(cnt != (*string_length)){
+    if(result == PARSE_ERR_COUNT){
         printf("[Error] no. of page reference and string's length not matched\n");
         exit(-2);
     }
-
-    if(find_min(string, *string_length) < 0){
+    if(result == PARSE_ERR_MIN){
         printf("[Error] page number can't be smaller than 0\n");
         exit(-2);
     }
-    if(find_max(string, *string_length) > (*page - 1)){
+    if(result == PARSE_ERR_MAX){
         printf("[Error] maximum page number can't be bigger than total page no.\n");
         exit(-2);
     }
@@ -799,6 +2012,99 @@ int *get_data(FILE *infile, int *page, int *page_frame, int *window, int *string
     return string;
 }
 
+/**
+ * get processes of multi-process mode from input file
+ * first line: no. of process, quantum, no. of shared page frame
+ * then each process follows single process format(A B C D, reference string)
+ *
+ * input:
+ *    FILE *infile: file pointer for input file
+ *
+ * output:
+ *    return Process *proc: array of processes(size: proc_no)
+ *    int *proc_no: no. of process
+ *    int *quantum: no. of reference a process runs before the next process
+ *    int *pool_size: no. of page frame shared by all processes
+ */
+Process *get_process(FILE *infile, int *proc_no, int *quantum, int *pool_size){
+    if(fscanf(infile, "%d %d %d\n", proc_no, quantum, pool_size) != 3){
+        printf("[Error] multi-process header(no. of process, quantum, pool size) not found\n");
+        exit(-2);
+    }
+    printf("%d %d %d\n", *proc_no, *quantum, *pool_size);
+
+    // file format check
+    if((*proc_no > PROC) || (*proc_no < 1)){
+        printf("[Error]The range of no. of process: 1~ %d\n", PROC);
+        exit(-2);
+    }
+    if(*quantum < 1){
+        printf("[Error]quantum should be bigger than 0\n");
+        exit(-2);
+    }
+    if((*pool_size > POOL) || (*pool_size < 1)){
+        printf("[Error]The range of no. of shared page frame: 1~ %d\n", POOL);
+        exit(-2);
+    }
+
+    Process *proc = (Process *)malloc(sizeof(Process) * (*proc_no));
+    if(proc == NULL){
+        printf("[Error] Dynamic memory allocation failed\n");
+        exit(-3);
+    }
+    for(int i = 0; i < *proc_no; i++){
+        proc[i].string = get_data(infile, &proc[i].page, &proc[i].page_frame, &proc[i].window, &proc[i].string_length);
+        if(proc[i].string_length < 1){
+            printf("[Error] reference string of process %d is empty\n", i);
+            exit(-2);
+        }
+    }
+    return proc;
+}
+
+/**
+ * get compression ratio of each page
+ * if the line after reference string has 'page' ratios, use them
+ * otherwise draw ratio from uniform distribution(ratio_min ~ ratio_max)
+ *
+ * input:
+ *    FILE *infile: file pointer for input file(right after reference string)
+ *    int page: no. of page of the process, size of ratio
+ *    Option *option: ratio_min, ratio_max
+ *
+ * output:
+ *    double *ratio: compression ratio of each page(original size / compressed size)
+ *    return int 1 (ratio from file), 0 (random ratio)
+ */
+int get_ratio(FILE *infile, int page, double *ratio, Option *option){
+    int cnt = 0;
+    for(int i = 0; i < page; i++){
+        if(fscanf(infile, "%lf ", &(ratio[i])) != 1){
+            break;
+        }
+        cnt++;
+    }
+    if(cnt == page){
+        for(int i = 0; i < page; i++){
+            if(ratio[i] < 1.0){
+                printf("[Error] compression ratio can't be smaller than 1.0\n");
+                exit(-2);
+            }
+        }
+        return 1;
+    }
+    if(cnt != 0){
+        printf("[Error] no. of compression ratio and no. of page not matched\n");
+        exit(-2);
+    }
+
+    srand(RATIO_SEED);
+    for(int i = 0; i < page; i++){
+        ratio[i] = option->ratio_min + (option->ratio_max - option->ratio_min) * rand() / RAND_MAX;
+    }
+    return 0;
+}
+
 int find_min(int *string, int size){
     int min = string[0];
     for(int i = 0; i < size; i++){
@@ -0,0 +1,263 @@
+/**
+ * Copyright (C) 2020 by Dongwon Kim, All rights reserved.
+ *
+ * Project 3 of Operating System: Virtual Memory Management
+ *
+ * File name : vm_instr.c
+ *
+ * Summery of this code:
+ *    1. build reuse distance histogram and reference count of page from the trace
+ *    2. count fault of page, fault of time window and cycles of *_replace for each policy
+ *    3. write <prefix>_reuse.csv, <prefix>_page.csv, <prefix>_fault.csv,
+ *       <prefix>_replace.csv and <prefix>.json
+ *
+ *  Modification History :
+ *    1. Written on October 19, 2026
+ *
+ *  Encoding : UTF - 8
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "vm_instr.h"
+
+static char *stat_name[] = {"MIN", "FIFO", "LRU", "LFU", "Clock", "WS"};
+
+/**
+ * allocate counters and build statistics of the trace
+ * reuse distance = no. of distinct page referenced since the last reference of the page
+ * (kept with LRU stack, O(page) for each reference)
+ *
+ * input:
+ *    int *string: array that contains reference string
+ *    int string_length: size of string
+ *    int page: no. of page of the process
+ *    int window: no. of reference of a fault rate window
+ *
+ * output:
+ *    Instr *ins: initialized instrumentation
+ *    return int VM_OK, VM_ERR_FORMAT(window < 1), VM_ERR_ALLOC
+ */
+int instr_create(Instr *ins, int *string, int string_length, int page, int window){
+    if(window < 1){
+        return VM_ERR_FORMAT;
+    }
+    ins->page = page;
+    ins->string_length = string_length;
+    ins->window = window;
+    ins->window_no = (string_length + window - 1) / window;
+    ins->reuse = (long *)calloc(page + 1, sizeof(long));
+    ins->page_ref = (long *)calloc(page, sizeof(long));
+    ins->page_fault = (long *)calloc((size_t)STAT_POLICY * page, sizeof(long));
+    ins->window_fault = (long *)calloc((size_t)STAT_POLICY * ins->window_no + 1, sizeof(long));
+    int *stack = (int *)malloc(sizeof(int) * (page + 1));
+    if(ins->reuse == NULL || ins->page_ref == NULL || ins->page_fault == NULL
+       || ins->window_fault == NULL || stack == NULL){
+        free(stack);
+        instr_free(ins);
+        return VM_ERR_ALLOC;
+    }
+    memset(ins->cycle, 0, sizeof(ins->cycle));
+    memset(ins->call, 0, sizeof(ins->call));
+
+    // stack[0] is most recently used page, depth = no. of page in stack
+    int depth = 0;
+    int d;
+    for(int i = 0; i < string_length; i++){
+        ins->page_ref[string[i]]++;
+        for(d = 0; d < depth; d++){
+            if(stack[d] == string[i]){
+                break;
+            }
+        }
+        if(d == depth){
+            ins->reuse[page]++;   // first reference(infinite distance)
+            depth++;
+        }else{
+            ins->reuse[d]++;
+        }
+        // move the page to the top of the stack
+        for(int k = d; k > 0; k--){
+            stack[k] = stack[k - 1];
+        }
+        stack[0] = string[i];
+    }
+    free(stack);
+    return VM_OK;
+}
+
+/**
+ * free counters of the instrumentation
+ *
+ * in/output:
+ *    Instr *ins: instrumentation to be freed
+ */
+void instr_free(Instr *ins){
+    free(ins->reuse);
+    free(ins->page_ref);
+    free(ins->page_fault);
+    free(ins->window_fault);
+    ins->reuse = NULL;
+    ins->page_ref = NULL;
+    ins->page_fault = NULL;
+    ins->window_fault = NULL;
+}
+
+/**
+ * read cycle counter
+ * time stamp counter on x86, virtual counter on arm64, ns of monotonic clock otherwise
+ *
+ * output:
+ *    return unsigned long long current cycle
+ */
+unsigned long long instr_cycle(void){
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    unsigned long long cnt;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(cnt));
+    return cnt;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+/**
+ * count a page fault
+ *
+ * input:
+ *    int policy: POL_MIN ~ POL_WS
+ *    int key: page no. which caused page fault
+ *    int time: time of the system, same as index of string
+ *
+ * in/output:
+ *    Instr *ins: page_fault, window_fault are updated
+ */
+void instr_fault(Instr *ins, int policy, int key, int time){
+    ins->page_fault[policy * ins->page + key]++;
+    ins->window_fault[policy * ins->window_no + time / ins->window]++;
+}
+
+/**
+ * count cycles of a *_replace call
+ *
+ * input:
+ *    int policy: POL_MIN ~ POL_CLOCK
+ *    unsigned long long cycle: cycles spent in the call
+ *
+ * in/output:
+ *    Instr *ins: cycle, call are updated
+ */
+void instr_replace(Instr *ins, int policy, unsigned long long cycle){
+    ins->cycle[policy] += cycle;
+    ins->call[policy]++;
+}
+
+/**
+ * write statistics to CSV files and a JSON file
+ *    <prefix>_reuse.csv: distance,count(distance -1: first reference)
+ *    <prefix>_page.csv: page,reference,fault of each policy
+ *    <prefix>_fault.csv: window start time,fault rate of each policy
+ *    <prefix>_replace.csv: policy,call,cycle,cycle per call
+ *    <prefix>.json: all of the above
+ *
+ * input:
+ *    Instr *ins: instrumentation to be written
+ *    char *prefix: path prefix of the files
+ *
+ * output:
+ *    return int VM_OK, -1(file opening failed)
+ */
+int instr_export(Instr *ins, char *prefix){
+    char path[FILENAME_MAX];
+    FILE *f[5];
+    char *suffix[5] = {"_reuse.csv", "_page.csv", "_fault.csv", "_replace.csv", ".json"};
+    int p, w, size;
+
+    for(int k = 0; k < 5; k++){
+        snprintf(path, sizeof(path), "%s%s", prefix, suffix[k]);
+        f[k] = fopen(path, "w");
+        if(f[k] == NULL){
+            for(int j = 0; j < k; j++){
+                fclose(f[j]);
+            }
+            return -1;
+        }
+    }
+
+    // reuse distance
+    fprintf(f[0], "distance,count\n");
+    fprintf(f[4], "{\n  \"reference\": %d,\n  \"page\": %d,\n  \"window\": %d,\n", ins->string_length, ins->page, ins->window);
+    fprintf(f[4], "  \"reuse_distance\": {\"first\": %ld, \"count\": [", ins->reuse[ins->page]);
+    fprintf(f[0], "-1,%ld\n", ins->reuse[ins->page]);
+    for(int d = 0; d < ins->page; d++){
+        fprintf(f[0], "%d,%ld\n", d, ins->reuse[d]);
+        fprintf(f[4], "%s%ld", d == 0 ? "" : ", ", ins->reuse[d]);
+    }
+    fprintf(f[4], "]},\n");
+
+    // reference and fault of each page
+    fprintf(f[1], "page,reference");
+    for(p = 0; p < STAT_POLICY; p++){
+        fprintf(f[1], ",%s", stat_name[p]);
+    }
+    fprintf(f[1], "\n");
+    fprintf(f[4], "  \"page_reference\": [");
+    for(int j = 0; j < ins->page; j++){
+        fprintf(f[1], "%d,%ld", j, ins->page_ref[j]);
+        for(p = 0; p < STAT_POLICY; p++){
+            fprintf(f[1], ",%ld", ins->page_fault[p * ins->page + j]);
+        }
+        fprintf(f[1], "\n");
+        fprintf(f[4], "%s%ld", j == 0 ? "" : ", ", ins->page_ref[j]);
+    }
+    fprintf(f[4], "],\n  \"policy\": {\n");
+
+    // fault rate of each window
+    fprintf(f[2], "time");
+    for(p = 0; p < STAT_POLICY; p++){
+        fprintf(f[2], ",%s", stat_name[p]);
+    }
+    fprintf(f[2], "\n");
+    for(w = 0; w < ins->window_no; w++){
+        size = (w + 1) * ins->window > ins->string_length ? ins->string_length - w * ins->window : ins->window;
+        fprintf(f[2], "%d", w * ins->window + 1);
+        for(p = 0; p < STAT_POLICY; p++){
+            fprintf(f[2], ",%.4lf", (double)ins->window_fault[p * ins->window_no + w] / size);
+        }
+        fprintf(f[2], "\n");
+    }
+
+    // cycles of *_replace(WS has no replace call)
+    fprintf(f[3], "policy,call,cycle,cycle_per_call\n");
+    for(p = 0; p < STAT_POLICY; p++){
+        double per_call = ins->call[p] == 0 ? 0 : (double)ins->cycle[p] / ins->call[p];
+        if(p != POL_WS){
+            fprintf(f[3], "%s,%ld,%llu,%.2lf\n", stat_name[p], ins->call[p], ins->cycle[p], per_call);
+        }
+
+        fprintf(f[4], "    \"%s\": {\n      \"page_fault\": [", stat_name[p]);
+        for(int j = 0; j < ins->page; j++){
+            fprintf(f[4], "%s%ld", j == 0 ? "" : ", ", ins->page_fault[p * ins->page + j]);
+        }
+        fprintf(f[4], "],\n      \"window_fault\": [");
+        for(w = 0; w < ins->window_no; w++){
+            fprintf(f[4], "%s%ld", w == 0 ? "" : ", ", ins->window_fault[p * ins->window_no + w]);
+        }
+        fprintf(f[4], "],\n      \"replace_call\": %ld,\n      \"replace_cycle\": %llu,\n"
+                "      \"cycle_per_call\": %.2lf\n    }%s\n",
+                ins->call[p], ins->cycle[p], per_call, p == STAT_POLICY - 1 ? "" : ",");
+    }
+    fprintf(f[4], "  }\n}\n");
+
+    for(int k = 0; k < 5; k++){
+        fclose(f[k]);
+    }
+    return VM_OK;
+}
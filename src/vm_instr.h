@@ -0,0 +1,56 @@
+/**
+ * Copyright (C) 2020 by Dongwon Kim, All rights reserved.
+ *
+ * Project 3 of Operating System: Virtual Memory Management
+ *
+ * File name : vm_instr.h
+ *
+ * Summery of this code:
+ *    1. statistics of the trace: reuse distance histogram, reference count of page
+ *    2. statistics of each policy: fault count of page, fault rate of each time window,
+ *       cycles spent in *_replace
+ *    3. export statistics as CSV and JSON
+ *
+ *  Modification History :
+ *    1. Written on October 19, 2026
+ *
+ *  Encoding : UTF - 8
+ */
+#ifndef VM_INSTR_H
+#define VM_INSTR_H
+
+#include "vm_rule.h"
+
+#define STAT_WINDOW 100     // default no. of reference of a fault rate window
+#define STAT_POLICY (POL_WS + 1)
+
+/*
+ * instrumentation of one trace
+ *    reuse[d]: no. of reference whose reuse(LRU stack) distance is d, reuse[page]: first reference
+ *    page_fault[policy * page + j]: no. of fault of page j under policy
+ *    window_fault[policy * window_no + w]: no. of fault in window w under policy
+ */
+typedef struct{
+    int page;                                   // no. of page of the process
+    int string_length;                          // length of reference string
+    int window;                                 // no. of reference of a window
+    int window_no;                              // no. of window
+    long *reuse;                                // size: page + 1
+    long *page_ref;                             // size: page
+    long *page_fault;                           // size: STAT_POLICY * page
+    long *window_fault;                         // size: STAT_POLICY * window_no
+    unsigned long long cycle[STAT_POLICY];      // cycles spent in *_replace
+    long call[STAT_POLICY];                     // no. of *_replace call
+} Instr;
+
+/*
+ * function prototypes
+ */
+int instr_create(Instr *ins, int *string, int string_length, int page, int window);
+void instr_free(Instr *ins);
+unsigned long long instr_cycle(void);
+void instr_fault(Instr *ins, int policy, int key, int time);
+void instr_replace(Instr *ins, int policy, unsigned long long cycle);
+int instr_export(Instr *ins, char *prefix);
+
+#endif
@@ -0,0 +1,363 @@
+/**
+ * Copyright (C) 2020 by Dongwon Kim, All rights reserved.
+ *
+ * Project 3 of Operating System: Virtual Memory Management
+ *
+ * File name : vm_parse.c
+ *
+ * Summery of this code:
+ *    1. map the input file and split the reference string into chunks at whitespace
+ *    2. each thread counts tokens of its chunk, then parses its integers into the
+ *       right position of ref(prefix sum of the counts)
+ *       counting stops at the window which holds n tokens, rest of the file is not read
+ *    3. range of page number is checked during parsing, no separate min / max pass
+ *    4. if the file can't be mapped(pipe, non-POSIX system), PARSE_ERR_MAP is returned
+ *       and the caller reads it with fscanf
+ *
+ *  Modification History :
+ *    1. Written on October 19, 2026
+ *    2. Scan bounded to the window holding n references on October 19, 2026
+ *
+ *  Encoding : UTF - 8
+ */
+// fileno, madvise are not in ISO C(needed with -std=c11 etc.)
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include "vm_parse.h"
+#if defined(__unix__) || defined(__APPLE__)
+#define PARSE_POSIX
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*
+ * work of one parser thread
+ * [begin, finish) of buf, tokens are stored from ref[base]
+ */
+typedef struct{
+    const char *buf;
+    size_t begin;        // first byte of the chunk(start of a token or whitespace)
+    size_t finish;       // byte after the chunk
+    int *ref;            // output array
+    int n;               // no. of reference to be parsed in total
+    int page;            // no. of page(valid page: 0 ~ page - 1)
+    long count;          // no. of token in the chunk(pass 1)
+    long base;           // index of ref for the first token(pass 2)
+    int bad;             // 1 if a token is not an integer
+    int below;           // 1 if a page number < 0
+    int above;           // 1 if a page number > page - 1
+    size_t end;          // byte after token n - 1, if it is in this chunk
+} Chunk;
+
+/**
+ * check if c is a whitespace as isspace() of "C" locale
+ */
+static int is_space(char c){
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+/**
+ * count tokens which start in the chunk(pass 1)
+ *
+ * in/output:
+ *    void *arg: Chunk, count is set
+ */
+static void *count_chunk(void *arg){
+    Chunk *c = (Chunk *)arg;
+    long count = 0;
+    int in_token = 0;
+    for(size_t i = c->begin; i < c->finish; i++){
+        if(is_space(c->buf[i])){
+            in_token = 0;
+        }else if(in_token == 0){
+            in_token = 1;
+            count++;
+        }
+    }
+    c->count = count;
+    return NULL;
+}
+
+/**
+ * parse tokens of the chunk into ref[base ~](pass 2)
+ * token: [+-]digits, value bigger than page is kept as page(no overflow)
+ *
+ * in/output:
+ *    void *arg: Chunk, bad, below, above, end are set
+ */
+static void *parse_chunk(void *arg){
+    Chunk *c = (Chunk *)arg;
+    const char *buf = c->buf;
+    size_t i = c->begin;
+    long index = c->base;
+    int value, sign;
+
+    while(i < c->finish && index < c->n){
+        if(is_space(buf[i])){
+            i++;
+            continue;
+        }
+        sign = 1;
+        if(buf[i] == '-' || buf[i] == '+'){
+            sign = buf[i] == '-' ? -1 : 1;
+            i++;
+        }
+        if(i >= c->finish || buf[i] < '0' || buf[i] > '9'){
+            c->bad = 1;
+        }
+        value = 0;
+        while(i < c->finish && buf[i] >= '0' && buf[i] <= '9'){
+            if(value <= c->page){
+                value = value * 10 + (buf[i] - '0');
+            }
+            i++;
+        }
+        // rest of the token is not a digit
+        if(i < c->finish && !is_space(buf[i])){
+            c->bad = 1;
+            while(i < c->finish && !is_space(buf[i])){
+                i++;
+            }
+        }
+        value *= sign;
+        if(value < 0){
+            c->below = 1;
+        }else if(value > c->page - 1){
+            c->above = 1;
+        }
+        c->ref[index] = value;
+        index++;
+        if(index == c->n){
+            c->end = i;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * run 'work' for each chunk, nthread chunks at a time
+ * first chunk of each group runs in the calling thread
+ *
+ * input:
+ *    int chunk_no: no. of chunk
+ *    int nthread: no. of thread(1 ~ PARSE_THREAD)
+ *
+ * in/output:
+ *    Chunk *chunk: chunks to be processed(size: chunk_no)
+ */
+static void run_chunks(void *(*work)(void *), Chunk *chunk, int chunk_no, int nthread){
+    for(int first = 0; first < chunk_no; first += nthread){
+        int last = first + nthread < chunk_no ? first + nthread : chunk_no;
+#ifdef PARSE_POSIX
+        pthread_t tid[PARSE_THREAD];
+        int created = first + 1;
+        for(int k = first + 1; k < last; k++){
+            if(pthread_create(&tid[k - first], NULL, work, &chunk[k]) != 0){
+                break;
+            }
+            created++;
+        }
+        work(&chunk[first]);
+        for(int k = first + 1; k < created; k++){
+            pthread_join(tid[k - first], NULL);
+        }
+        // thread creation failed: do the rest in this thread
+        for(int k = created; k < last; k++){
+            work(&chunk[k]);
+        }
+#else
+        for(int k = first; k < last; k++){
+            work(&chunk[k]);
+        }
+#endif
+    }
+}
+
+/**
+ * parse n page references from buf with several threads
+ * only the window expected to hold n references is counted, and the window is
+ * extended until n references are found, so the rest of buf is not read
+ *
+ * input:
+ *    const char *buf: text of reference string(need not end with '\0')
+ *    size_t len: byte of buf
+ *    int n: no. of reference to be parsed(string length)
+ *    int page: no. of page(valid page: 0 ~ page - 1)
+ *    int nthread: no. of thread(1 ~ PARSE_THREAD, smaller for small window)
+ *
+ * output:
+ *    int *ref: parsed references(size: n)
+ *    size_t *end: byte after the n-th reference(len if fewer than n)
+ *    return int PARSE_OK, PARSE_ERR_COUNT, PARSE_ERR_MIN, PARSE_ERR_MAX(checked in this order),
+ *               PARSE_ERR_ALLOC
+ */
+int parse_refs(const char *buf, size_t len, int *ref, int n, int page, int nthread, size_t *end){
+    Chunk *chunk = NULL, *grow;
+    int chunk_no = 0, room = 0, round_no;
+    long total = 0;
+    size_t scanned = 0, limit, size, per;
+
+    if(nthread > PARSE_THREAD){
+        nthread = PARSE_THREAD;
+    }
+    if(nthread < 1){
+        nthread = 1;
+    }
+
+    // pass 1: count tokens of [scanned, limit) until n tokens are found
+    limit = (size_t)n < len / PARSE_GUESS ? (size_t)n * PARSE_GUESS + 1 : len;
+    while(1){
+        // a token which crosses the end of the window belongs to the window
+        while(limit < len && limit > 0 && !is_space(buf[limit]) && !is_space(buf[limit - 1])){
+            limit++;
+        }
+        size = limit - scanned;
+        round_no = size / PARSE_CHUNK < (size_t)nthread ? (int)(size / PARSE_CHUNK) : nthread;
+        if(round_no < 1){
+            round_no = 1;
+        }
+        if(chunk_no + round_no > room){
+            room = (chunk_no + round_no) * 2;
+            grow = (Chunk *)realloc(chunk, sizeof(Chunk) * room);
+            if(grow == NULL){
+                free(chunk);
+                return PARSE_ERR_ALLOC;
+            }
+            chunk = grow;
+        }
+
+        // split at whitespace: a token which crosses the border belongs to the former chunk
+        for(int k = 0; k < round_no; k++){
+            Chunk *c = &chunk[chunk_no + k];
+            size_t begin = scanned + size / round_no * k;
+            while(k > 0 && begin < limit && !is_space(buf[begin]) && !is_space(buf[begin - 1])){
+                begin++;
+            }
+            c->buf = buf;
+            c->begin = begin;
+            c->finish = limit;
+            c->ref = ref;
+            c->n = n;
+            c->page = page;
+            c->bad = c->below = c->above = 0;
+            c->end = len;
+            if(k > 0){
+                chunk[chunk_no + k - 1].finish = begin;
+            }
+        }
+        run_chunks(count_chunk, &chunk[chunk_no], round_no, nthread);
+        for(int k = chunk_no; k < chunk_no + round_no; k++){
+            chunk[k].base = total;
+            total += chunk[k].count;
+        }
+        chunk_no += round_no;
+        if(total >= n || limit == len){
+            break;
+        }
+
+        // next window from byte per token so far
+        scanned = limit;
+        per = scanned / (total > 0 ? (size_t)total : 1) + 1;
+        limit = (size_t)(n - total) < (len - scanned) / per ? scanned + (size_t)(n - total) * per : len;
+        limit = len - limit > PARSE_CHUNK ? limit + PARSE_CHUNK : len;
+    }
+
+    // pass 2: parse at the position given by prefix sum
+    run_chunks(parse_chunk, chunk, chunk_no, nthread);
+
+    int bad = 0, below = 0, above = 0;
+    *end = n == 0 ? 0 : len;
+    for(int k = 0; k < chunk_no; k++){
+        bad |= chunk[k].bad;
+        below |= chunk[k].below;
+        above |= chunk[k].above;
+        if(chunk[k].base < n && chunk[k].base + chunk[k].count >= n){
+            *end = chunk[k].end;
+        }
+    }
+    free(chunk);
+    if(total < n || bad){
+        return PARSE_ERR_COUNT;
+    }
+    if(below){
+        return PARSE_ERR_MIN;
+    }
+    if(above){
+        return PARSE_ERR_MAX;
+    }
+    return PARSE_OK;
+}
+
+/**
+ * get byte of infile after the current position, if it can be parsed by parse_file
+ * (regular file on POSIX system)
+ *
+ * input:
+ *    FILE *infile: file pointer for input file
+ *
+ * output:
+ *    return long remaining byte, -1(parse_file returns PARSE_ERR_MAP)
+ */
+long parse_remain(FILE *infile){
+#ifdef PARSE_POSIX
+    struct stat st;
+    long offset = ftell(infile);
+    int fd = fileno(infile);
+    if(offset < 0 || fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)){
+        return -1;
+    }
+    return st.st_size > offset ? (long)(st.st_size - offset) : 0;
+#else
+    (void)infile;
+    return -1;
+#endif
+}
+
+/**
+ * parse n page references from the current position of infile
+ * the file is memory mapped and parsed by parse_refs with a thread per core,
+ * then the file position is moved right after the n-th reference
+ *
+ * input:
+ *    FILE *infile: file pointer for input file(after the header)
+ *    int n: no. of reference to be parsed(string length)
+ *    int page: no. of page(valid page: 0 ~ page - 1)
+ *
+ * output:
+ *    int *ref: parsed references(size: n)
+ *    return int return code of parse_refs, or PARSE_ERR_MAP(caller should use fscanf)
+ */
+int parse_file(FILE *infile, int *ref, int n, int page){
+#ifdef PARSE_POSIX
+    struct stat st;
+    long offset = ftell(infile);
+    int fd = fileno(infile);
+    if(offset < 0 || fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= offset){
+        return PARSE_ERR_MAP;
+    }
+
+    // map whole file(mmap offset should be page aligned)
+    size_t size = (size_t)st.st_size;
+    char *map = (char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(map == MAP_FAILED){
+        return PARSE_ERR_MAP;
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+
+    long core = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t end;
+    int result = parse_refs(map + offset, size - offset, ref, n, page, core < 1 ? 1 : (int)core, &end);
+    munmap(map, size);
+    fseek(infile, offset + (long)end, SEEK_SET);
+    return result;
+#else
+    (void)infile;
+    (void)ref;
+    (void)n;
+    (void)page;
+    return PARSE_ERR_MAP;
+#endif
+}
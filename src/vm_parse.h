@@ -0,0 +1,44 @@
+/**
+ * Copyright (C) 2020 by Dongwon Kim, All rights reserved.
+ *
+ * Project 3 of Operating System: Virtual Memory Management
+ *
+ * File name : vm_parse.h
+ *
+ * Summery of this code:
+ *    1. parse page reference string of text input with several threads
+ *       (memory mapped file, split at whitespace, range checked while parsing)
+ *    2. only the part of the file holding the reference string is read
+ *
+ *  Modification History :
+ *    1. Written on October 19, 2026
+ *    2. parse_remain added on October 19, 2026
+ *
+ *  Encoding : UTF - 8
+ */
+#ifndef VM_PARSE_H
+#define VM_PARSE_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define PARSE_THREAD 16          // limit of no. of parser thread
+#define PARSE_CHUNK (1 << 16)    // minimum byte of a chunk for one thread
+#define PARSE_GUESS 4            // expected byte of a reference(e.g. "12 ") for the first window
+
+// return code
+#define PARSE_OK 0
+#define PARSE_ERR_COUNT -1       // not an integer or fewer reference than string length
+#define PARSE_ERR_MIN -2         // page number smaller than 0
+#define PARSE_ERR_MAX -3         // page number bigger than page - 1
+#define PARSE_ERR_ALLOC -4       // dynamic memory allocation failed
+#define PARSE_ERR_MAP -5         // input can't be memory mapped(use fscanf)
+
+/*
+ * function prototypes
+ */
+int parse_refs(const char *buf, size_t len, int *ref, int n, int page, int nthread, size_t *end);
+int parse_file(FILE *infile, int *ref, int n, int page);
+long parse_remain(FILE *infile);
+
+#endif
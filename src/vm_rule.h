@@ -0,0 +1,45 @@
+/**
+ * Copyright (C) 2020 by Dongwon Kim, All rights reserved.
+ *
+ * Project 3 of Operating System: Virtual Memory Management
+ *
+ * File name : vm_rule.h
+ *
+ * Summery of this code:
+ *    1. replace rule of MIN, FIFO, LRU, LFU, Clock used by every test and vm_sim.c
+ *       (internal header, not for user of the simulator library)
+ *
+ *  Modification History :
+ *    1. Split from vm_sim.h on October 19, 2026
+ *
+ *  Encoding : UTF - 8
+ */
+#ifndef VM_RULE_H
+#define VM_RULE_H
+
+#include "vm_sim.h"
+
+// policy(index of policy_name)
+#define POL_MIN VM_POL_MIN
+#define POL_FIFO VM_POL_FIFO
+#define POL_LRU VM_POL_LRU
+#define POL_LFU VM_POL_LFU
+#define POL_CLOCK VM_POL_CLOCK
+#define POL_WS VM_POL_WS
+
+/*
+ * function prototypes
+ */
+// primary functions
+void mem_init(int *mem, int page_frame);
+int in_mem(int *mem, int page_frame, int key);
+// replace rule
+int MIN_replace(int *mark, int *mem, int page_frame, const int *string, int string_length, int time);
+int FIFO_replace(int *mem, int *mark, int page_frame);
+int LRU_replace(int *mem, int *mark, int page_frame);
+int LFU_replace(int *mem, int *mark, int *tie_break, int page_frame);
+int Clock_replace(int *mem, int *mark, int page_frame, int *needle);
+int select_victim(int policy, int *mem, int *mark, int *tie_break, int page_frame, int *needle);
+void mark_use(int policy, int *mark, int *tie_break, int index, int time, int load);
+
+#endif
@@ -0,0 +1,551 @@
+/**
+ * Copyright (C) 2020 by Dongwon Kim, All rights reserved.
+ *
+ * Project 3 of Operating System: Virtual Memory Management
+ *
+ * File name : vm_sim.c
+ *
+ * Summery of this code:
+ *    1. replace rule of MIN, FIFO, LRU, LFU, Clock used by every test(vm_rule.h)
+ *    2. re-entrant simulator of one process for MIN, FIFO, LRU, LFU, Clock, WS
+ *       - all state is kept in VMSim(no static, no global), so many simulators
+ *         can run at the same time
+ *       - reference string is fed in batches, errors are returned(VM_ERR_*)
+ *
+ *  Modification History :
+ *    1. Replace rule split from virtual_memory_management.c, simulator API added
+ *       on October 19, 2026
+ *    2. Time of simulator kept in long, time in mark rebased before int overflow
+ *       on October 19, 2026
+ *
+ *  Encoding : UTF - 8
+ */
+#include <stdlib.h>
+#include <limits.h>
+#include "vm_rule.h"
+#define FALSE -1
+#define MARK_LIMIT (INT_MAX / 2)   // time given to replace rule is rebased at this value
+
+/*
+ * state of one simulator
+ *    fixed allocation: mem, mark(, tie_break) have page_frame elements as in *_test
+ *    WS: mark has used time of each page(page elements, -1: not in memory) as page_mark
+ */
+struct VMSim{
+    int policy;          // POL_MIN ~ POL_WS
+    int page;            // no. of page of the process
+    int page_frame;      // no. of page frame allocated(not used in WS)
+    int window;          // window size(WS only)
+    int *mem;            // page no. which are in the page frame
+    int *mark;           // information for replacement
+    int *tie_break;      // used time of pages(LFU only)
+    int *rank;           // work space of vm_rank
+    int needle;          // clock hand(Clock only)
+    long time;           // no. of reference fed so far(= time of the system)
+    long base;           // time - base is the time saved in mark, tie_break(< MARK_LIMIT)
+    int resident;        // no. of frame occupied now
+    long fault;          // no. of page fault
+    long frame_sum;      // sum of resident over time(for average)
+};
+
+static void vm_rebase(VMSim *sim);
+static void vm_rank(int *mark, int *rank, int size);
+
+/**
+ * create a simulator of one process
+ *
+ * input:
+ *    int policy: POL_MIN, POL_FIFO, POL_LRU, POL_LFU, POL_CLOCK, POL_WS
+ *    int page: no. of page of the process(reference should be 0 ~ page - 1)
+ *    int page_frame: no. of page frame allocated(ignored in WS)
+ *    int window: window size(WS only)
+ *
+ * output:
+ *    VMSim **sim: created simulator(NULL on error)
+ *    return int VM_OK, VM_ERR_FORMAT(argument out of range), VM_ERR_ALLOC
+ */
+int vm_create(VMSim **sim, int policy, int page, int page_frame, int window){
+    *sim = NULL;
+    if((policy < POL_MIN) || (policy > POL_WS) || (page < 1)){
+        return VM_ERR_FORMAT;
+    }
+    if((policy != POL_WS && (page_frame < 1 || page_frame >= MARK_LIMIT / 2))
+       || (policy == POL_WS && (window < 0 || window >= MARK_LIMIT / 2))){
+        return VM_ERR_FORMAT;
+    }
+
+    VMSim *s = (VMSim *)malloc(sizeof(VMSim));
+    if(s == NULL){
+        return VM_ERR_ALLOC;
+    }
+    s->policy = policy;
+    s->page = page;
+    s->page_frame = policy == POL_WS ? page : page_frame;
+    s->window = window;
+    s->needle = 0;
+    s->time = 0;
+    s->base = 0;
+    s->resident = 0;
+    s->fault = 0;
+    s->frame_sum = 0;
+    s->mem = (int *)malloc(sizeof(int) * s->page_frame);
+    s->mark = (int *)malloc(sizeof(int) * s->page_frame);
+    s->tie_break = (int *)malloc(sizeof(int) * s->page_frame);
+    s->rank = (int *)malloc(sizeof(int) * s->page_frame);
+    if(s->mem == NULL || s->mark == NULL || s->tie_break == NULL || s->rank == NULL){
+        vm_destroy(s);
+        return VM_ERR_ALLOC;
+    }
+    mem_init(s->mem, s->page_frame);
+    mem_init(s->mark, s->page_frame);
+    mem_init(s->tie_break, s->page_frame);
+
+    *sim = s;
+    return VM_OK;
+}
+
+/**
+ * feed a batch of page references to the simulator
+ * whole batch is checked first, so nothing is simulated if an error is returned.
+ * MIN looks forward only inside the batch(feed whole string at once for exact MIN).
+ *
+ * input:
+ *    const int *ref: page references(size: n)
+ *    int n: no. of reference
+ *
+ * output:
+ *    return int VM_OK, VM_ERR_FORMAT(reference out of range or n < 0)
+ *
+ * in/output:
+ *    VMSim *sim: simulator
+ */
+int vm_feed(VMSim *sim, const int *ref, int n){
+    int key, index, replace, limit, time;
+
+    if(sim == NULL || n < 0 || (n > 0 && ref == NULL)){
+        return VM_ERR_FORMAT;
+    }
+    for(int k = 0; k < n; k++){
+        if((ref[k] < 0) || (ref[k] >= sim->page)){
+            return VM_ERR_FORMAT;
+        }
+    }
+
+    for(int k = 0; k < n; k++, sim->time++){
+        key = ref[k];
+        if(sim->time - sim->base >= MARK_LIMIT){
+            vm_rebase(sim);
+        }
+        time = (int)(sim->time - sim->base);
+
+        // WS: same as WS_test, mark = used time of each page
+        if(sim->policy == POL_WS){
+            if(sim->mark[key] == -1){
+                sim->fault++;
+            }
+            sim->mark[key] = time;
+            limit = time - sim->window;
+            sim->resident = 0;
+            for(int j = 0; j < sim->page; j++){
+                if(limit > sim->mark[j]){
+                    sim->mark[j] = -1;
+                }
+                if(sim->mark[j] != -1){
+                    sim->resident++;
+                }
+            }
+            sim->frame_sum += sim->resident;
+            continue;
+        }
+
+        // fixed allocation: same as MIN_test, FIFO_test, LRU_test, LFU_test, Clock_test
+        index = in_mem(sim->mem, sim->page_frame, key);
+        if(index != FALSE){
+            if(sim->policy != POL_MIN){
+                mark_use(sim->policy, sim->mark, sim->tie_break, index, time, 0);
+            }
+        }else{
+            if(sim->policy == POL_MIN){
+                replace = MIN_replace(sim->mark, sim->mem, sim->page_frame, ref, n, k);
+            }else{
+                replace = select_victim(sim->policy, sim->mem, sim->mark, sim->tie_break, sim->page_frame, &sim->needle);
+                mark_use(sim->policy, sim->mark, sim->tie_break, replace, time, 1);
+            }
+            if(sim->mem[replace] == -1){
+                sim->resident++;
+            }
+            sim->mem[replace] = key;
+            sim->fault++;
+        }
+        sim->frame_sum += sim->resident;
+    }
+    return VM_OK;
+}
+
+/**
+ * rebase time saved in mark, tie_break so that int does not overflow on a long run
+ * order(FIFO, LRU, tie_break of LFU) and distance within window(WS) are kept
+ *    FIFO, LRU, LFU: used / arrival time is replaced by its rank among the frames
+ *    LFU: used count is halved while it is over MARK_LIMIT
+ *    WS: used time in window is shifted by time - window
+ *
+ * in/output:
+ *    VMSim *sim: simulator, base is moved forward
+ */
+static void vm_rebase(VMSim *sim){
+    int time = (int)(sim->time - sim->base);
+    int shift, max;
+
+    if(sim->policy == POL_WS){
+        // every page in memory has used time >= time - 1 - window
+        shift = time - 1 - sim->window;
+        for(int j = 0; j < sim->page; j++){
+            if(sim->mark[j] != -1){
+                sim->mark[j] -= shift;
+            }
+        }
+        sim->base += shift;
+        return;
+    }
+    if(sim->policy == POL_FIFO || sim->policy == POL_LRU){
+        vm_rank(sim->mark, sim->rank, sim->page_frame);
+    }else if(sim->policy == POL_LFU){
+        vm_rank(sim->tie_break, sim->rank, sim->page_frame);
+        do{
+            max = 0;
+            for(int i = 0; i < sim->page_frame; i++){
+                if(sim->mark[i] > max){
+                    max = sim->mark[i];
+                }
+            }
+            if(max > MARK_LIMIT){
+                for(int i = 0; i < sim->page_frame; i++){
+                    if(sim->mark[i] > 1){
+                        sim->mark[i] /= 2;
+                    }
+                }
+            }
+        }while(max > MARK_LIMIT);
+    }
+    // every rank is smaller than page_frame
+    sim->base = sim->time - sim->page_frame;
+}
+
+/**
+ * replace each time(>= 0) by no. of time smaller than it(-1 is kept)
+ *
+ * input:
+ *    int size: size of mark, rank
+ *
+ * in/output:
+ *    int *mark: time of each frame -> rank of each frame
+ *    int *rank: work space
+ */
+static void vm_rank(int *mark, int *rank, int size){
+    for(int i = 0; i < size; i++){
+        rank[i] = mark[i];
+        if(mark[i] < 0){
+            continue;
+        }
+        rank[i] = 0;
+        for(int j = 0; j < size; j++){
+            if(mark[j] >= 0 && mark[j] < mark[i]){
+                rank[i]++;
+            }
+        }
+    }
+    for(int i = 0; i < size; i++){
+        mark[i] = rank[i];
+    }
+}
+
+/**
+ * get statistics of the simulator
+ *
+ * input:
+ *    const VMSim *sim: simulator
+ *
+ * output:
+ *    VMStats *stats: no. of reference, fault, resident frame and average frame
+ *    return int VM_OK, VM_ERR_FORMAT(NULL argument)
+ */
+int vm_stats(const VMSim *sim, VMStats *stats){
+    if(sim == NULL || stats == NULL){
+        return VM_ERR_FORMAT;
+    }
+    stats->reference = sim->time;
+    stats->fault = sim->fault;
+    stats->resident = sim->resident;
+    stats->avg_frame = sim->time == 0 ? 0 : (double)sim->frame_sum / sim->time;
+    return VM_OK;
+}
+
+/**
+ * free the simulator(NULL is allowed)
+ *
+ * input:
+ *    VMSim *sim: simulator to be freed
+ */
+void vm_destroy(VMSim *sim){
+    if(sim == NULL){
+        return;
+    }
+    free(sim->mem);
+    free(sim->mark);
+    free(sim->tie_break);
+    free(sim->rank);
+    free(sim);
+}
+
+/**
+ * initialize pointer array
+ * (allocation should be checked by the caller)
+ *
+ * input:
+ *    int page_frame: the no. of page frame allocated to the process
+ *
+ * in/output:
+ *    int *mem: pointer array that is initialized as -1.
+ */
+void mem_init(int *mem, int page_frame){
+    for(int i = 0; i < page_frame; i++){
+        mem[i] = -1;
+    }
+}
+
+/**
+ * check if the 'key' is in the array (using linear search)
+ *
+ * input:
+ *    int *mem: the array to be searched
+ *    int page_frame: the size of the array
+ *    int key: the value to be found
+ *
+ * output:
+ *    return int index of the key(if the key is in the array)
+ *           int FALSE(-1) (if search failed)
+ */
+int in_mem(int *mem, int page_frame, int key){
+    for(int i = 0; i < page_frame; i++){
+        if(key == mem[i]){
+            return i;
+        }
+    }
+    return FALSE;
+}
+
+/**
+ * find index to be replaced following MIN algorithm
+ *
+ * input:
+ *    int *mem: array to save page no. which are in the page frame
+ *    int page_frame: no. of page frame allocated, size of mem, mark
+ *    int *string: array that contains reference string
+ *    int string_length: size of string
+ *    int time: time of the system, same as index of string + 1
+ *
+ * output:
+ *    return int index to be replaced
+ *
+ * in/output:
+ *    int *mark: save forward distance of page
+ */
+int MIN_replace(int *mark, int *mem, int page_frame, const int *string, int string_length, int time){
+    int change = 0;
+    for(int i = 0; i < page_frame; i++){
+        for(int j = time; j < string_length; j++){
+            // if the page is referred again in the future, save forward distance
+            if(string[j] == mem[i]){
+                mark[i] = j - time;
+                change = 1;
+                break;
+            }
+        }
+        // if the page is not referred again, save string_length(infinity)
+        // since max forward distance = string_length - 1
+        if(change != 1){
+            mark[i] = string_length;
+        }
+        change = 0;
+    }
+
+    // find page that has maximum forward distance
+    int max = mark[0];
+    int max_no = 0;
+    for(int i = 0; i < page_frame; i++){
+        if(max < mark[i]){
+            max = mark[i];
+            max_no = i;
+        }
+    }
+    return max_no;
+}
+
+/**
+ * find index to be replaced following FIFO algorithm
+ *
+ * input:
+ *    int *mem: array to save page no. which are in the page frame
+ *    int *mark: array that has arrival time of pages in the memory
+ *    int page_frame: no. of page frame allocated, size of mem, mark
+ *
+ * output:
+ *    return int index to be replaced(index that has minimum arrival time)
+ */
+int FIFO_replace(int *mem, int *mark, int page_frame){
+    int min = mark[0];
+    int min_no = 0;
+    for(int i = 0; i < page_frame; i++){
+        if(min > mark[i]){
+            min = mark[i];
+            min_no = i;
+        }
+    }
+    return min_no;
+}
+
+/**
+ * find index to be replaced following LRU algorithm
+ *
+ * input:
+ *    int *mem: array to save page no. which are in the page frame
+ *    int *mark: array that has arrival time of pages in the memory
+ *    int page_frame: no. of page frame allocated, size of mem, mark
+ *
+ * output:
+ *    return int index to be replaced(index that has minimum used time)
+ */
+int LRU_replace(int *mem, int *mark, int page_frame){
+    int min = mark[0];
+    int min_no = 0;
+    for(int i = 0; i < page_frame; i++){
+        if(min > mark[i]){
+            min = mark[i];
+            min_no = i;
+        }
+    }
+    return min_no;
+}
+
+/**
+ * find index to be replaced following LFU algorithm
+ *
+ * input:
+ *    int *mem: array to save page no. which are in the page frame
+ *    int *mark: array that has used count of pages in the memory
+ *    int *tie_break: array that has used time of pages in the memory
+ *    int page_frame: no. of page frame allocated, size of mem, mark, tie_break
+ *
+ * output:
+ *    return int index to be replaced(index that has minimum used count)
+ */
+int LFU_replace(int *mem, int *mark, int *tie_break, int page_frame){
+    int min = mark[0];
+    int min_no = 0;
+    for(int i = 0; i < page_frame; i++){
+        if(min > mark[i]){
+            min = mark[i];
+        }
+    }
+    int tie_min = tie_break[0];
+    // if the page has same used count with minimum value, tie_break by LRU
+    for(int i = 0; i < page_frame; i++){
+        if(mark[i] == min){
+            if(tie_min > tie_break[i]){
+                tie_min = tie_break[i];
+                min_no = i;
+            }
+        }
+    }
+    return min_no;
+}
+
+/**
+ * find index to be replaced following Clock algorithm
+ *
+ * input:
+ *    int *mem: array to save page no. which are in the page frame
+ *    int *mark: array that has reference bit of pages in the memory
+ *    int page_frame: no. of page frame allocated, size of mem, mark
+ *
+ * output:
+ *    return int index to be replaced(index whose reference bit  == 0)
+ *
+ * in/output:
+ *    int *needle: position of the clock hand, hold by caller for next search
+ */
+int Clock_replace(int *mem, int *mark, int page_frame, int *needle){
+    int replace;
+    // find page whose reference bit == 0
+    while(1){
+        if(mark[*needle] == 0){
+            replace = *needle;
+            (*needle)++;
+            *needle = *needle % page_frame;
+            break;
+        // if reference bit == 1, change to 0 and examine next page
+        }else{
+            mark[*needle] = 0;
+            (*needle)++;
+            *needle = *needle % page_frame;
+        }
+    }
+    return replace;
+}
+
+/**
+ * find index to be replaced following replace rule of 'policy'
+ *
+ * input:
+ *    int policy: POL_FIFO, POL_LRU, POL_LFU, POL_CLOCK
+ *    int *mem: array to save page no. which are in the page frame
+ *    int page_frame: no. of page frame allocated, size of mem, mark
+ *
+ * output:
+ *    return int index to be replaced
+ *
+ * in/output:
+ *    int *mark: array that has information for replacement
+ *    int *tie_break: used time of pages(LFU only)
+ *    int *needle: clock hand(Clock only)
+ */
+int select_victim(int policy, int *mem, int *mark, int *tie_break, int page_frame, int *needle){
+    if(policy == POL_FIFO){
+        return FIFO_replace(mem, mark, page_frame);
+    }else if(policy == POL_LRU){
+        return LRU_replace(mem, mark, page_frame);
+    }else if(policy == POL_LFU){
+        return LFU_replace(mem, mark, tie_break, page_frame);
+    }else{
+        return Clock_replace(mem, mark, page_frame, needle);
+    }
+}
+
+/**
+ * update information for replacement when the frame is referenced or loaded
+ * same as FIFO_test, LRU_test, LFU_test, Clock_test
+ *
+ * input:
+ *    int policy: POL_FIFO, POL_LRU, POL_LFU, POL_CLOCK
+ *    int index: index of the frame
+ *    int time: time of the system
+ *    int load: 1(page is loaded to the frame), 0(page in the frame is referenced)
+ *
+ * in/output:
+ *    int *mark: array that has information for replacement
+ *    int *tie_break: used time of pages(LFU only)
+ */
+void mark_use(int policy, int *mark, int *tie_break, int index, int time, int load){
+    if(policy == POL_FIFO){
+        if(load == 1){
+            mark[index] = time;   // mark arrival time
+        }
+    }else if(policy == POL_LRU){
+        mark[index] = time;       // mark used time
+    }else if(policy == POL_LFU){
+        mark[index] = load == 1 ? 1 : mark[index] + 1;  // used count
+        tie_break[index] = time;  // mark used time
+    }else{
+        mark[index] = 1;          // reference bit = 1
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2020 by Dongwon Kim, All rights reserved.
+ *
+ * Project 3 of Operating System: Virtual Memory Management
+ *
+ * File name : vm_sim.h
+ *
+ * Summery of this code:
+ *    1. public API of re-entrant simulator of one process(create, feed, stats, destroy)
+ *       only vm_* and VM_* names are exported, replace rule is in vm_rule.h
+ *
+ *  Modification History :
+ *    1. Replace rule split from virtual_memory_management.c, simulator API added
+ *       on October 19, 2026
+ *    2. Replace rule moved to vm_rule.h on October 19, 2026
+ *
+ *  Encoding : UTF - 8
+ */
+#ifndef VM_SIM_H
+#define VM_SIM_H
+
+// policy(index of policy_name)
+#define VM_POL_MIN 0
+#define VM_POL_FIFO 1
+#define VM_POL_LRU 2
+#define VM_POL_LFU 3
+#define VM_POL_CLOCK 4
+#define VM_POL_WS 5
+
+// return code(same value as exit code of virtual_memory_management)
+#define VM_OK 0
+#define VM_ERR_FORMAT -2    // argument or page reference out of range
+#define VM_ERR_ALLOC -3     // dynamic memory allocation failed
+
+/*
+ * simulator of one process, contents are hidden in vm_sim.c
+ */
+typedef struct VMSim VMSim;
+
+/*
+ * statistics of a simulator
+ */
+typedef struct{
+    long reference;      // no. of reference fed
+    long fault;          // no. of page fault
+    int resident;        // no. of frame occupied now
+    double avg_frame;    // average no. of frame occupied(same as WS_test)
+} VMStats;
+
+/*
+ * function prototypes
+ */
+int vm_create(VMSim **sim, int policy, int page, int page_frame, int window);
+int vm_feed(VMSim *sim, const int *ref, int n);
+int vm_stats(const VMSim *sim, VMStats *stats);
+void vm_destroy(VMSim *sim);
+
+#endif
@@ -0,0 +1,19 @@
+#!/bin/sh
+# compare simulator library(src/vm_sim.c) with virtual_memory_management
+# for every data/input*.txt, run from the top directory: sh test/check_vm_sim.sh
+top=$(pwd)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+gcc -pthread -o "$work/virtual_memory_management" src/virtual_memory_management.c src/vm_sim.c src/vm_instr.c src/vm_parse.c || exit 1
+gcc -Isrc -o "$work/vm_sim_check" test/vm_sim_check.c src/vm_sim.c || exit 1
+
+fail=0
+cd "$work" || exit 1
+for f in "$top"/data/input*.txt "$top"/data/rand_input.txt; do
+    echo "$f" | ./virtual_memory_management > /dev/null
+    echo "== $(basename "$f")"
+    ./vm_sim_check "$f" output.txt || fail=1
+done
+[ $fail = 0 ] && echo "all matched"
+exit $fail
@@ -0,0 +1,180 @@
+/**
+ * Copyright (C) 2020 by Dongwon Kim, All rights reserved.
+ *
+ * Project 3 of Operating System: Virtual Memory Management
+ *
+ * File name : vm_sim_check.c
+ *
+ * Summery of this code:
+ *    1. feed reference string of an input file to the simulator library(vm_sim.h)
+ *       for MIN, FIFO, LRU, LFU, Clock, WS
+ *    2. compare no. of fault(and average frame of WS) with output.txt written by
+ *       virtual_memory_management for the same input file
+ *    3. FIFO ~ WS are fed again in batches of 1, 3, 7 references, which should give
+ *       the same result(MIN looks forward only inside a batch, so it is fed at once)
+ *
+ *  Modification History :
+ *    1. Written on October 19, 2026
+ *
+ *  Encoding : UTF - 8
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vm_sim.h"
+#define LINE_LENGTH 1000  // limit of a line of output.txt
+#define POLICY (VM_POL_WS + 1)
+
+const char *policy_name[POLICY] = {"MIN", "FIFO", "LRU", "LFU", "Clock", "WS"};
+const int batch[] = {1, 3, 7};
+
+int get_result(FILE *outfile, long *fault, long *reference, double *avg_frame);
+int run_library(int policy, int page, int page_frame, int window, int *string, int string_length,
+                int size, VMStats *stats);
+
+/**
+ * check simulator library against output.txt
+ *
+ * input:
+ *    argv[1]: input file of virtual_memory_management
+ *    argv[2]: output.txt of virtual_memory_management for argv[1]
+ *
+ * output:
+ *    print result of each policy at the console
+ *    return int 0 (all matched), 1 (not matched), -1 (file opening failed),
+ *               -2 (file format error)
+ */
+int main(int argc, char *argv[]){
+    if(argc != 3){
+        printf("usage: %s <input file> <output.txt of the input>\n", argv[0]);
+        return -1;
+    }
+    FILE *infile = fopen(argv[1], "r");
+    FILE *outfile = fopen(argv[2], "r");
+    if(infile == NULL || outfile == NULL){
+        printf("[Error] file opening failed\n");
+        return -1;
+    }
+
+    int page, page_frame, window, string_length;
+    if(fscanf(infile, "%d %d %d %d", &page, &page_frame, &window, &string_length) != 4 || string_length < 1){
+        printf("[Error] %s: header not matched\n", argv[1]);
+        return -2;
+    }
+    int *string = (int *)malloc(sizeof(int) * string_length);
+    if(string == NULL){
+        printf("[Error] Dynamic memory allocation failed\n");
+        return -3;
+    }
+    for(int i = 0; i < string_length; i++){
+        if(fscanf(infile, "%d", &string[i]) != 1){
+            printf("[Error] %s: no. of page reference and string's length not matched\n", argv[1]);
+            return -2;
+        }
+    }
+    fclose(infile);
+
+    long fault[POLICY], reference[POLICY];
+    double avg_frame = 0;
+    if(get_result(outfile, fault, reference, &avg_frame) != 0){
+        printf("[Error] %s: result of every policy not found\n", argv[2]);
+        return -2;
+    }
+    fclose(outfile);
+
+    int mismatch = 0;
+    VMStats stats;
+    for(int p = VM_POL_MIN; p <= VM_POL_WS; p++){
+        int ok = 1;
+        for(int b = -1; b < (int)(sizeof(batch) / sizeof(batch[0])); b++){
+            if(b >= 0 && p == VM_POL_MIN){
+                break;
+            }
+            int size = b < 0 ? string_length : batch[b];
+            if(run_library(p, page, page_frame, window, string, string_length, size, &stats) != VM_OK){
+                printf("%s: [Error] simulator returned error(batch %d)\n", policy_name[p], size);
+                ok = 0;
+                continue;
+            }
+            // WS average is printed with 2 digits
+            if(stats.fault != fault[p] || stats.reference != reference[p]
+               || (p == VM_POL_WS && (long)(stats.avg_frame * 100 + 0.5) != (long)(avg_frame * 100 + 0.5))){
+                printf("%s: fault %ld/%ld(batch %d), output.txt %ld/%ld\n", policy_name[p],
+                       stats.fault, stats.reference, size, fault[p], reference[p]);
+                ok = 0;
+            }
+        }
+        if(ok == 1){
+            printf("%s: fault %ld/%ld matched\n", policy_name[p], fault[p], reference[p]);
+        }else{
+            mismatch = 1;
+        }
+    }
+    free(string);
+    return mismatch;
+}
+
+/**
+ * get no. of fault of each policy from output.txt
+ * result is the "Total no. of fault: a/b" line after "--<policy>--"
+ *
+ * input:
+ *    FILE *outfile: output.txt of virtual_memory_management
+ *
+ * output:
+ *    long *fault, *reference: no. of fault and reference of each policy(size: POLICY)
+ *    double *avg_frame: average page frame no. of WS
+ *    return int 0 (every policy found), -1 (not found)
+ */
+int get_result(FILE *outfile, long *fault, long *reference, double *avg_frame){
+    char line[LINE_LENGTH], title[LINE_LENGTH];
+    int policy = -1, found = 0;
+    while(fgets(line, LINE_LENGTH, outfile) != NULL){
+        // only the normal test: stop at the first optional test(prefetch, tier, ...)
+        if(sscanf(line, "--%[^-]--", title) == 1){
+            policy = -1;
+            for(int p = 0; p < POLICY; p++){
+                if(strcmp(title, policy_name[p]) == 0 && (found & (1 << p)) == 0){
+                    policy = p;
+                }
+            }
+        }else if(policy != -1 && sscanf(line, "Total no. of fault: %ld/%ld", &fault[policy], &reference[policy]) == 2){
+            found |= 1 << policy;
+            policy = -1;
+        }else if(policy == VM_POL_WS){
+            sscanf(line, "average page frame no.: %lf", avg_frame);
+        }
+    }
+    return found == (1 << POLICY) - 1 ? 0 : -1;
+}
+
+/**
+ * run one simulator over the whole string
+ *
+ * input:
+ *    int policy: VM_POL_MIN ~ VM_POL_WS
+ *    int page, page_frame, window: argument of vm_create
+ *    int *string: array that contains reference string
+ *    int string_length: size of string
+ *    int size: no. of reference given to vm_feed at once
+ *
+ * output:
+ *    VMStats *stats: statistics after the whole string
+ *    return int VM_OK or error of vm_create, vm_feed
+ */
+int run_library(int policy, int page, int page_frame, int window, int *string, int string_length,
+                int size, VMStats *stats){
+    VMSim *sim;
+    int result = vm_create(&sim, policy, page, page_frame, window);
+    if(result != VM_OK){
+        return result;
+    }
+    for(int i = 0; i < string_length && result == VM_OK; i += size){
+        result = vm_feed(sim, string + i, i + size > string_length ? string_length - i : size);
+    }
+    if(result == VM_OK){
+        result = vm_stats(sim, stats);
+    }
+    vm_destroy(sim);
+    return result;
+}